@@ -0,0 +1,108 @@
+//! Measures the throughput of indexing the assets in Bethesda archives when
+//! loading plugins.
+//!
+//! Run using `cargo bench --bench archives`. Each case generates a plugin with
+//! an associated BA2 that contains the given number of file paths, and reports
+//! the number of archive entries indexed per second.
+
+use std::{
+    fs::{File, create_dir_all},
+    io::{BufWriter, Write},
+    path::Path,
+    time::{Duration, Instant},
+};
+
+use libloot::{Game, GameType};
+
+const ENTRY_COUNTS: [u32; 3] = [10_000, 100_000, 500_000];
+const ITERATIONS: u32 = 5;
+const PLUGIN_NAME: &str = "Bench.esp";
+
+fn main() {
+    let tmp_dir = tempfile::tempdir().unwrap();
+    let game_path = tmp_dir.path().join("game");
+    let local_path = tmp_dir.path().join("local");
+    let data_path = game_path.join("Data");
+    create_dir_all(&data_path).unwrap();
+    create_dir_all(&local_path).unwrap();
+
+    write_plugin(&data_path.join(PLUGIN_NAME));
+
+    for entry_count in ENTRY_COUNTS {
+        write_ba2(&data_path.join("Bench - Textures.ba2"), entry_count);
+
+        let mut game = Game::with_local_path(GameType::Fallout4, &game_path, &local_path).unwrap();
+        let plugin_path = data_path.join(PLUGIN_NAME);
+
+        let mut timings = Vec::new();
+        for _ in 0..ITERATIONS {
+            let start = Instant::now();
+            game.load_plugins(&[plugin_path.as_path()]).unwrap();
+            timings.push(start.elapsed());
+
+            assert!(game.plugin(PLUGIN_NAME).is_some());
+        }
+
+        report(entry_count, &timings);
+    }
+}
+
+fn report(entry_count: u32, timings: &[Duration]) {
+    let best = timings.iter().min().copied().unwrap_or_default();
+    let total: Duration = timings.iter().sum();
+    let mean = total / u32::try_from(timings.len()).unwrap();
+
+    let entries_per_second = f64::from(entry_count) / best.as_secs_f64();
+
+    println!(
+        "{entry_count:>7} entries: best {best:>10.3?}, mean {mean:>10.3?}, {entries_per_second:>12.0} entries/s"
+    );
+}
+
+/// Write a minimal Fallout 4 plugin that contains only a TES4 header record.
+fn write_plugin(path: &Path) {
+    let mut header = Vec::new();
+    header.extend_from_slice(b"TES4");
+    header.extend_from_slice(&18u32.to_le_bytes()); // Data size
+    header.extend_from_slice(&0u32.to_le_bytes()); // Flags
+    header.extend_from_slice(&0u32.to_le_bytes()); // FormID
+    header.extend_from_slice(&0u32.to_le_bytes()); // Version control info
+    header.extend_from_slice(&131u16.to_le_bytes()); // Form version
+    header.extend_from_slice(&0u16.to_le_bytes()); // Unknown
+
+    header.extend_from_slice(b"HEDR");
+    header.extend_from_slice(&12u16.to_le_bytes());
+    header.extend_from_slice(&1.0f32.to_le_bytes()); // Version
+    header.extend_from_slice(&0u32.to_le_bytes()); // Number of records
+    header.extend_from_slice(&0x800u32.to_le_bytes()); // Next object ID
+
+    std::fs::write(path, header).unwrap();
+}
+
+/// Write a general BA2 that contains only a header and a file path table with
+/// the given number of entries, which is all that's read when indexing assets.
+fn write_ba2(path: &Path, entry_count: u32) {
+    const HEADER_SIZE: u64 = 24;
+
+    let mut writer = BufWriter::new(File::create(path).unwrap());
+
+    writer.write_all(b"BTDX").unwrap();
+    writer.write_all(&1u32.to_le_bytes()).unwrap();
+    writer.write_all(b"GNRL").unwrap();
+    writer.write_all(&entry_count.to_le_bytes()).unwrap();
+    writer.write_all(&HEADER_SIZE.to_le_bytes()).unwrap();
+
+    for i in 0..entry_count {
+        // Use mixed case and forward slashes so that paths need normalising.
+        let file_path = format!(
+            "Textures/Bench/Folder{:04}/Sub Folder/Texture{i:08}_D.DDS",
+            i % 1000
+        );
+        let length = u16::try_from(file_path.len()).unwrap();
+
+        writer.write_all(&length.to_le_bytes()).unwrap();
+        writer.write_all(file_path.as_bytes()).unwrap();
+    }
+
+    writer.flush().unwrap();
+}
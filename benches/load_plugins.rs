@@ -0,0 +1,110 @@
+//! Measures how long it takes to load a set of plugins that contains one
+//! plugin much larger than the others.
+//!
+//! Run using `cargo bench --bench load_plugins`. Each case generates the given
+//! number of small plugins and one large plugin, which is listed last, and
+//! reports the time taken to load all of them.
+
+use std::{
+    fs::{File, create_dir_all},
+    io::{BufWriter, Write},
+    path::{Path, PathBuf},
+    time::{Duration, Instant},
+};
+
+use libloot::{Game, GameType};
+
+const SMALL_PLUGIN_COUNTS: [u32; 3] = [16, 64, 256];
+const SMALL_PLUGIN_RECORD_COUNT: u32 = 10_000;
+const LARGE_PLUGIN_RECORD_COUNT: u32 = 2_000_000;
+const ITERATIONS: u32 = 5;
+
+fn main() {
+    let tmp_dir = tempfile::tempdir().unwrap();
+    let game_path = tmp_dir.path().join("game");
+    let local_path = tmp_dir.path().join("local");
+    let data_path = game_path.join("Data");
+    create_dir_all(&data_path).unwrap();
+    create_dir_all(&local_path).unwrap();
+
+    let large_plugin_path = data_path.join("Large.esm");
+    write_plugin(&large_plugin_path, LARGE_PLUGIN_RECORD_COUNT);
+
+    for small_plugin_count in SMALL_PLUGIN_COUNTS {
+        let mut plugin_paths: Vec<PathBuf> = (0..small_plugin_count)
+            .map(|i| data_path.join(format!("Small{i:04}.esp")))
+            .collect();
+
+        for path in &plugin_paths {
+            if !path.exists() {
+                write_plugin(path, SMALL_PLUGIN_RECORD_COUNT);
+            }
+        }
+
+        plugin_paths.push(large_plugin_path.clone());
+        let plugin_paths: Vec<_> = plugin_paths.iter().map(PathBuf::as_path).collect();
+
+        let mut game = Game::with_local_path(GameType::Fallout4, &game_path, &local_path).unwrap();
+
+        let mut timings = Vec::new();
+        for _ in 0..ITERATIONS {
+            let start = Instant::now();
+            game.load_plugins(&plugin_paths).unwrap();
+            timings.push(start.elapsed());
+
+            assert_eq!(plugin_paths.len(), game.loaded_plugins().len());
+        }
+
+        report(small_plugin_count, &timings);
+    }
+}
+
+fn report(small_plugin_count: u32, timings: &[Duration]) {
+    let best = timings.iter().min().copied().unwrap_or_default();
+    let total: Duration = timings.iter().sum();
+    let mean = total / u32::try_from(timings.len()).unwrap();
+
+    println!("{small_plugin_count:>4} small plugins: best {best:>10.3?}, mean {mean:>10.3?}");
+}
+
+/// Write a Fallout 4 plugin that contains a TES4 header record and a single
+/// top-level group holding the given number of empty records.
+fn write_plugin(path: &Path, record_count: u32) {
+    const RECORD_HEADER_SIZE: u32 = 24;
+
+    let mut writer = BufWriter::new(File::create(path).unwrap());
+
+    writer.write_all(b"TES4").unwrap();
+    writer.write_all(&18u32.to_le_bytes()).unwrap(); // Data size
+    writer.write_all(&0u32.to_le_bytes()).unwrap(); // Flags
+    writer.write_all(&0u32.to_le_bytes()).unwrap(); // FormID
+    writer.write_all(&0u32.to_le_bytes()).unwrap(); // Version control info
+    writer.write_all(&131u16.to_le_bytes()).unwrap(); // Form version
+    writer.write_all(&0u16.to_le_bytes()).unwrap(); // Unknown
+
+    writer.write_all(b"HEDR").unwrap();
+    writer.write_all(&12u16.to_le_bytes()).unwrap();
+    writer.write_all(&1.0f32.to_le_bytes()).unwrap(); // Version
+    writer.write_all(&record_count.to_le_bytes()).unwrap(); // Number of records
+    writer.write_all(&0x800u32.to_le_bytes()).unwrap(); // Next object ID
+
+    let group_size = RECORD_HEADER_SIZE * (record_count + 1);
+    writer.write_all(b"GRUP").unwrap();
+    writer.write_all(&group_size.to_le_bytes()).unwrap(); // Size including header
+    writer.write_all(b"MISC").unwrap(); // Label
+    writer.write_all(&0u32.to_le_bytes()).unwrap(); // Group type
+    writer.write_all(&0u32.to_le_bytes()).unwrap(); // Timestamp
+    writer.write_all(&0u32.to_le_bytes()).unwrap(); // Version control info
+
+    for i in 0..record_count {
+        writer.write_all(b"MISC").unwrap();
+        writer.write_all(&0u32.to_le_bytes()).unwrap(); // Data size
+        writer.write_all(&0u32.to_le_bytes()).unwrap(); // Flags
+        writer.write_all(&(0x800 + i).to_le_bytes()).unwrap(); // FormID
+        writer.write_all(&0u32.to_le_bytes()).unwrap(); // Version control info
+        writer.write_all(&131u16.to_le_bytes()).unwrap(); // Form version
+        writer.write_all(&0u16.to_le_bytes()).unwrap(); // Unknown
+    }
+
+    writer.flush().unwrap();
+}
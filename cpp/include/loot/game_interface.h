@@ -24,6 +24,8 @@
 #ifndef LOOT_GAME_INTERFACE
 #define LOOT_GAME_INTERFACE
 
+#include <utility>
+
 #include "loot/database_interface.h"
 #include "loot/enum/game_type.h"
 #include "loot/plugin_interface.h"
@@ -40,6 +42,20 @@ public:
    */
   virtual GameType GetType() const = 0;
 
+  /**
+   * @brief Set the number of threads that this game uses for parallel work,
+   *        such as loading plugins.
+   * @details If the thread count is non-zero, this game gets its own thread
+   *          pool with that many threads, which is not shared with any other
+   *          GameInterface. If the thread count is zero, this game uses a
+   *          global thread pool, which has one thread per logical CPU core.
+   *          This is the default.
+   * @param threadCount
+   *        The number of threads to use, or zero to use the global thread
+   *        pool.
+   */
+  virtual void SetThreadCount(size_t threadCount) = 0;
+
   /**
    * @brief   Gets the currently-set additional data paths.
    * @details The following games are configured with additional data paths by
@@ -102,6 +118,22 @@ public:
    */
   virtual bool IsValidPlugin(const std::filesystem::path& pluginPath) const = 0;
 
+  /**
+   * @brief Get the given files that are valid plugins.
+   * @details Each file is checked in the same way as `IsValidPlugin()`, and
+   *          the files are checked in parallel. The results are cached using
+   *          each file's path, size and modification time, so checking an
+   *          unchanged file again only needs to read its metadata.
+   * @param  pluginPaths
+   *         The paths to the files to check. Relative paths are resolved
+   *         relative to the game's plugins directory, while absolute paths are
+   *         used as given.
+   * @returns The paths of the given files that are valid plugins, in the order
+   *          they were given.
+   */
+  virtual std::vector<std::filesystem::path> FilterValidPlugins(
+      const std::vector<std::filesystem::path>& pluginPaths) const = 0;
+
   /**
    * @brief Parses plugins and loads their data.
    * @details If a given plugin filename (or one that is case-insensitively
@@ -190,6 +222,14 @@ public:
    * @details This function should be called whenever the load order or active
    *          state of plugins "on disk" changes, so that the cached state is
    *          updated to reflect the changes.
+   *
+   *          If the modification times and sizes of the load order's source
+   *          files and of the entries in the game's plugin directories have
+   *          not changed since the state was last loaded, the load order is
+   *          not read again, but the condition cache is still cleared.
+   *
+   *          Throws without changing any state if there are moves made by
+   *          `MovePlugins()` that have not been written by `FlushLoadOrder()`.
    */
   virtual void LoadCurrentLoadOrderState() = 0;
 
@@ -228,6 +268,17 @@ public:
    */
   virtual std::vector<std::string> GetLoadOrder() const = 0;
 
+  /**
+   * @brief Get a view of the current load order.
+   * @details The returned vector is shared and immutable. It is only replaced
+   *          when the load order is changed by `LoadCurrentLoadOrderState()`
+   *          or `SetLoadOrder()`, so getting it does not copy the load order,
+   *          and a view that has been obtained is unaffected by later changes.
+   * @returns A pointer to a vector of plugin filenames in their load order.
+   */
+  virtual std::shared_ptr<const std::vector<std::string>> GetLoadOrderView()
+      const = 0;
+
   /**
    * @brief Set the game's load order.
    * @details There is no way to persist the load order of inactive OpenMW
@@ -237,6 +288,32 @@ public:
    *        A vector of plugin filenames sorted in the load order to set.
    */
   virtual void SetLoadOrder(const std::vector<std::string>& loadOrder) = 0;
+
+  /**
+   * @brief Move plugins to new positions in the game's load order.
+   * @details The moves are applied in the given order, and only the moved
+   *          plugins are validated. If any of the moves are invalid, none of
+   *          them are applied.
+   *
+   *          The new load order is only written when `FlushLoadOrder()` is
+   *          called, so that many moves can be written together. **Call
+   *          `FlushLoadOrder()` before calling `LoadCurrentLoadOrderState()`**,
+   *          which throws while there are moves that have not been written.
+   *          Moves that have not been written are discarded if this
+   *          GameInterface is destroyed first.
+   * @param moves
+   *        A vector of pairs of plugin filenames and the positions to move
+   *        them to.
+   */
+  virtual void MovePlugins(
+      const std::vector<std::pair<std::string, size_t>>& moves) = 0;
+
+  /**
+   * @brief Write any load order changes made by `MovePlugins()` that have not
+   *        yet been written.
+   * @details Does nothing if there are no unwritten changes.
+   */
+  virtual void FlushLoadOrder() = 0;
 };
 }
 
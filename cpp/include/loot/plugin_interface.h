@@ -84,8 +84,12 @@ public:
 
   /**
    * Get the plugin's CRC-32 checksum.
+   *
+   * The checksum is calculated the first time it is requested.
    * @return An optional containing the plugin's CRC-32 checksum if the plugin
    *         has been fully loaded, otherwise an optional containing no value.
+   *         The optional also contains no value if the plugin file could not
+   *         be read or has changed since the plugin was loaded.
    */
   virtual std::optional<uint32_t> GetCRC() const = 0;
 
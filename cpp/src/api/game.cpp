@@ -102,7 +102,9 @@ Game::Game(const GameType gameType,
            const std::filesystem::path& gamePath,
            const std::filesystem::path& localDataPath) :
     game_(constructGame(gameType, gamePath, localDataPath)),
-    database_(game_->database()) {}
+    database_(game_->database()),
+    loadOrder_(std::make_shared<const std::vector<std::string>>(
+        convert<std::string>(game_->load_order()))) {}
 
 GameType Game::GetType() const {
   try {
@@ -112,6 +114,14 @@ GameType Game::GetType() const {
   }
 }
 
+void Game::SetThreadCount(size_t threadCount) {
+  try {
+    game_->set_thread_count(threadCount);
+  } catch (const ::rust::Error& e) {
+    std::rethrow_exception(mapError(e));
+  }
+}
+
 const DatabaseInterface& Game::GetDatabase() const { return database_; }
 
 DatabaseInterface& Game::GetDatabase() { return database_; }
@@ -149,6 +159,28 @@ bool Game::IsValidPlugin(const std::filesystem::path& pluginPath) const {
   return game_->is_valid_plugin(pluginPath.u8string());
 }
 
+std::vector<std::filesystem::path> Game::FilterValidPlugins(
+    const std::vector<std::filesystem::path>& pluginPaths) const {
+  std::vector<::rust::String> path_strings;
+  std::vector<::rust::Str> path_strs;
+  for (const auto& path : pluginPaths) {
+    path_strings.push_back(path.u8string());
+    path_strs.push_back(path_strings.back());
+  }
+
+  try {
+    std::vector<std::filesystem::path> validPaths;
+    for (const auto& path_string : game_->filter_valid_plugins(
+             ::rust::Slice<const ::rust::Str>(path_strs))) {
+      validPaths.push_back(to_path(path_string));
+    }
+
+    return validPaths;
+  } catch (const ::rust::Error& e) {
+    std::rethrow_exception(mapError(e));
+  }
+}
+
 void Game::LoadPlugins(const std::vector<std::filesystem::path>& pluginPaths,
                        bool loadHeadersOnly) {
   std::vector<::rust::String> path_strings;
@@ -212,8 +244,11 @@ std::vector<std::string> Game::SortPlugins(
 
 void Game::LoadCurrentLoadOrderState() {
   try {
-    game_->load_current_load_order_state();
+    if (game_->load_current_load_order_state()) {
+      RefreshLoadOrder();
+    }
   } catch (const ::rust::Error& e) {
+    RefreshLoadOrder();
     std::rethrow_exception(mapError(e));
   }
 }
@@ -238,8 +273,11 @@ bool Game::IsPluginActive(const std::string& pluginName) const {
   return game_->is_plugin_active(pluginName);
 }
 
-std::vector<std::string> Game::GetLoadOrder() const {
-  return convert<std::string>(game_->load_order());
+std::vector<std::string> Game::GetLoadOrder() const { return *loadOrder_; }
+
+std::shared_ptr<const std::vector<std::string>> Game::GetLoadOrderView()
+    const {
+  return loadOrder_;
 }
 
 void Game::SetLoadOrder(const std::vector<std::string>& loadOrder) {
@@ -247,8 +285,42 @@ void Game::SetLoadOrder(const std::vector<std::string>& loadOrder) {
 
   try {
     game_->set_load_order(::rust::Slice(strs));
+    RefreshLoadOrder();
+  } catch (const ::rust::Error& e) {
+    RefreshLoadOrder();
+    std::rethrow_exception(mapError(e));
+  }
+}
+
+void Game::MovePlugins(
+    const std::vector<std::pair<std::string, size_t>>& moves) {
+  std::vector<::rust::Str> names;
+  std::vector<size_t> positions;
+  for (const auto& [name, position] : moves) {
+    names.push_back(name);
+    positions.push_back(position);
+  }
+
+  try {
+    game_->move_plugins(::rust::Slice<const ::rust::Str>(names),
+                        ::rust::Slice<const size_t>(positions));
+    RefreshLoadOrder();
+  } catch (const ::rust::Error& e) {
+    RefreshLoadOrder();
+    std::rethrow_exception(mapError(e));
+  }
+}
+
+void Game::FlushLoadOrder() {
+  try {
+    game_->flush_load_order();
   } catch (const ::rust::Error& e) {
     std::rethrow_exception(mapError(e));
   }
 }
+
+void Game::RefreshLoadOrder() {
+  loadOrder_ = std::make_shared<const std::vector<std::string>>(
+      convert<std::string>(game_->load_order()));
+}
 }
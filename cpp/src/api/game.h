@@ -22,6 +22,8 @@ public:
 
   GameType GetType() const override;
 
+  void SetThreadCount(size_t threadCount) override;
+
   std::vector<std::filesystem::path> GetAdditionalDataPaths() const override;
 
   void SetAdditionalDataPaths(
@@ -32,6 +34,9 @@ public:
 
   bool IsValidPlugin(const std::filesystem::path& pluginPath) const override;
 
+  std::vector<std::filesystem::path> FilterValidPlugins(
+      const std::vector<std::filesystem::path>& pluginPaths) const override;
+
   void LoadPlugins(const std::vector<std::filesystem::path>& pluginPaths,
                    bool loadHeadersOnly) override;
 
@@ -56,11 +61,22 @@ public:
 
   std::vector<std::string> GetLoadOrder() const override;
 
+  std::shared_ptr<const std::vector<std::string>> GetLoadOrderView()
+      const override;
+
   void SetLoadOrder(const std::vector<std::string>& loadOrder) override;
 
+  void MovePlugins(
+      const std::vector<std::pair<std::string, size_t>>& moves) override;
+
+  void FlushLoadOrder() override;
+
 private:
+  void RefreshLoadOrder();
+
   ::rust::Box<loot::rust::Game> game_;
   Database database_;
+  std::shared_ptr<const std::vector<std::string>> loadOrder_;
 };
 }
 
@@ -5,7 +5,7 @@ use libloot::{
     error::{
         ConditionEvaluationError, DatabaseLockPoisonError, GameHandleCreationError,
         GroupsPathError, LoadOrderError, LoadOrderStateError, LoadPluginsError,
-        MetadataRetrievalError, PluginDataError, SortPluginsError,
+        MetadataRetrievalError, PluginDataError, SortPluginsError, ThreadPoolCreationError,
     },
     metadata::error::{
         LoadMetadataError, MultilingualMessageContentsError, RegexError, WriteMetadataError,
@@ -57,6 +57,7 @@ variant_box_from_error!(MetadataRetrievalError, VerboseError::Other);
 variant_box_from_error!(LoadOrderError, VerboseError::Other);
 variant_box_from_error!(LoadOrderStateError, VerboseError::Other);
 variant_box_from_error!(PluginDataError, VerboseError::Other);
+variant_box_from_error!(ThreadPoolCreationError, VerboseError::Other);
 
 impl From<GameHandleCreationError> for VerboseError {
     fn from(value: GameHandleCreationError) -> Self {
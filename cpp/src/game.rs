@@ -1,4 +1,4 @@
-use std::path::Path;
+use std::{num::NonZeroUsize, path::Path, sync::Arc};
 
 use delegate::delegate;
 use libloot_ffi_errors::UnsupportedEnumValueError;
@@ -113,6 +113,13 @@ impl Game {
         self.0.game_type().try_into().map_err(Into::into)
     }
 
+    // CXX doesn't support Option<NonZeroUsize>, so zero means no thread count.
+    pub fn set_thread_count(&mut self, thread_count: usize) -> Result<(), VerboseError> {
+        self.0
+            .set_thread_count(NonZeroUsize::new(thread_count))
+            .map_err(Into::into)
+    }
+
     pub fn additional_data_paths(&self) -> Result<Vec<String>, VerboseError> {
         self.0
             .additional_data_paths()
@@ -138,6 +145,14 @@ impl Game {
         self.0.is_valid_plugin(Path::new(plugin_path))
     }
 
+    pub fn filter_valid_plugins(&self, plugin_paths: &[&str]) -> Result<Vec<String>, VerboseError> {
+        self.0
+            .filter_valid_plugins(&strings_to_paths(plugin_paths))
+            .into_iter()
+            .map(path_to_string)
+            .collect()
+    }
+
     pub fn load_plugins(&mut self, plugin_paths: &[&str]) -> Result<(), VerboseError> {
         self.0
             .load_plugins(&strings_to_paths(plugin_paths))
@@ -166,8 +181,14 @@ impl Game {
         self.0.sort_plugins(plugin_names).map_err(Into::into)
     }
 
-    pub fn load_current_load_order_state(&mut self) -> Result<(), VerboseError> {
-        self.0.load_current_load_order_state().map_err(Into::into)
+    /// Returns true if the load order may have changed, i.e. if its snapshot
+    /// was replaced.
+    pub fn load_current_load_order_state(&mut self) -> Result<bool, VerboseError> {
+        let snapshot = self.0.load_order_snapshot();
+
+        self.0.load_current_load_order_state()?;
+
+        Ok(!Arc::ptr_eq(&snapshot, &self.0.load_order_snapshot()))
     }
 
     pub fn is_load_order_ambiguous(&self) -> Result<bool, VerboseError> {
@@ -179,17 +200,33 @@ impl Game {
     }
 
     pub fn load_order(&self) -> Vec<String> {
-        self.0
-            .load_order()
-            .iter()
-            .map(ToString::to_string)
-            .collect()
+        self.0.load_order().to_vec()
     }
 
     pub fn set_load_order(&mut self, load_order: &[&str]) -> Result<(), VerboseError> {
         self.0.set_load_order(load_order).map_err(Into::into)
     }
 
+    // CXX doesn't support slices of tuples, so the moves are given as two
+    // slices of the same length.
+    pub fn move_plugins(
+        &mut self,
+        plugin_names: &[&str],
+        positions: &[usize],
+    ) -> Result<(), VerboseError> {
+        let moves: Vec<_> = plugin_names
+            .iter()
+            .copied()
+            .zip(positions.iter().copied())
+            .collect();
+
+        self.0.move_plugins(&moves).map_err(Into::into)
+    }
+
+    pub fn flush_load_order(&mut self) -> Result<(), VerboseError> {
+        self.0.flush_load_order().map_err(Into::into)
+    }
+
     delegate! {
         to self.0 {
             pub fn clear_loaded_plugins(&mut self);
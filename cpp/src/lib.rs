@@ -300,6 +300,8 @@ mod ffi {
 
         pub fn game_type(&self) -> Result<GameType>;
 
+        pub fn set_thread_count(&mut self, thread_count: usize) -> Result<()>;
+
         pub fn additional_data_paths(&self) -> Result<Vec<String>>;
 
         pub fn set_additional_data_paths(&mut self, additional_data_paths: &[&str]) -> Result<()>;
@@ -308,6 +310,8 @@ mod ffi {
 
         pub fn is_valid_plugin(&self, plugin_path: &str) -> bool;
 
+        pub fn filter_valid_plugins(&self, plugin_paths: &[&str]) -> Result<Vec<String>>;
+
         pub fn load_plugins(&mut self, plugin_paths: &[&str]) -> Result<()>;
 
         pub fn load_plugin_headers(&mut self, plugin_paths: &[&str]) -> Result<()>;
@@ -320,7 +324,7 @@ mod ffi {
 
         pub fn sort_plugins(&self, plugin_names: &[&str]) -> Result<Vec<String>>;
 
-        pub fn load_current_load_order_state(&mut self) -> Result<()>;
+        pub fn load_current_load_order_state(&mut self) -> Result<bool>;
 
         pub fn is_load_order_ambiguous(&self) -> Result<bool>;
 
@@ -331,6 +335,10 @@ mod ffi {
         pub fn load_order(&self) -> Vec<String>;
 
         pub fn set_load_order(&mut self, load_order: &[&str]) -> Result<()>;
+
+        pub fn move_plugins(&mut self, plugin_names: &[&str], positions: &[usize]) -> Result<()>;
+
+        pub fn flush_load_order(&mut self) -> Result<()>;
     }
 
     extern "Rust" {
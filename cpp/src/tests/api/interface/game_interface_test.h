@@ -137,6 +137,17 @@ TEST_P(GameInterfaceTest,
   EXPECT_EQ(loadOrder, handle_->GetLoadOrder());
 }
 
+TEST_P(GameInterfaceTest, loadPluginsShouldUseTheConfiguredThreadCount) {
+  ASSERT_NO_THROW(handle_->SetThreadCount(2));
+  ASSERT_NO_THROW(handle_->LoadPlugins({blankEsm, blankEsp}, false));
+
+  EXPECT_NE(nullptr, handle_->GetPlugin(blankEsm));
+  EXPECT_NE(nullptr, handle_->GetPlugin(blankEsp));
+
+  ASSERT_NO_THROW(handle_->SetThreadCount(0));
+  ASSERT_NO_THROW(handle_->LoadPlugins({blankEsm}, true));
+}
+
 TEST_P(GameInterfaceTest, isValidPluginShouldReturnTrueForAValidPlugin) {
   EXPECT_TRUE(handle_->IsValidPlugin(blankEsm));
 }
@@ -146,6 +157,15 @@ TEST_P(GameInterfaceTest,
   EXPECT_TRUE(handle_->IsValidPlugin(std::filesystem::u8path(nonAsciiEsm)));
 }
 
+TEST_P(GameInterfaceTest,
+       filterValidPluginsShouldReturnOnlyTheValidPluginsInTheGivenOrder) {
+  const std::vector<std::filesystem::path> paths{
+      blankEsp, nonPluginFile, blankEsm};
+
+  EXPECT_EQ(std::vector<std::filesystem::path>({blankEsp, blankEsm}),
+            handle_->FilterValidPlugins(paths));
+}
+
 TEST_P(GameInterfaceTest, isValidPluginShouldReturnFalseForANonPluginFile) {
   EXPECT_FALSE(handle_->IsValidPlugin(nonPluginFile));
 }
@@ -621,6 +641,53 @@ TEST_P(GameInterfaceTest, getLoadOrderShouldReturnTheCurrentLoadOrder) {
   }
 }
 
+TEST_P(GameInterfaceTest,
+       getLoadOrderViewShouldReturnTheSameViewUntilTheLoadOrderIsSet) {
+  handle_->LoadCurrentLoadOrderState();
+
+  const auto view = handle_->GetLoadOrderView();
+  ASSERT_NE(nullptr, view);
+  EXPECT_EQ(handle_->GetLoadOrder(), *view);
+
+  handle_->LoadCurrentLoadOrderState();
+
+  EXPECT_EQ(view, handle_->GetLoadOrderView());
+
+  handle_->SetLoadOrder(*view);
+
+  EXPECT_NE(view, handle_->GetLoadOrderView());
+  EXPECT_EQ(handle_->GetLoadOrder(), *handle_->GetLoadOrderView());
+}
+
+TEST_P(GameInterfaceTest,
+       movePluginsShouldNotChangeTheLoadOrderIfPluginsAreNotMoved) {
+  handle_->LoadCurrentLoadOrderState();
+
+  const auto loadOrder = handle_->GetLoadOrder();
+  ASSERT_FALSE(loadOrder.empty());
+
+  handle_->MovePlugins({{loadOrder.back(), loadOrder.size() - 1}});
+  handle_->FlushLoadOrder();
+
+  EXPECT_EQ(loadOrder, handle_->GetLoadOrder());
+}
+
+TEST_P(GameInterfaceTest,
+       loadCurrentLoadOrderStateShouldThrowIfMovesHaveNotBeenFlushed) {
+  handle_->LoadCurrentLoadOrderState();
+
+  const auto loadOrder = handle_->GetLoadOrder();
+  ASSERT_FALSE(loadOrder.empty());
+
+  handle_->MovePlugins({{loadOrder.back(), loadOrder.size() - 1}});
+
+  EXPECT_ANY_THROW(handle_->LoadCurrentLoadOrderState());
+
+  handle_->FlushLoadOrder();
+
+  EXPECT_NO_THROW(handle_->LoadCurrentLoadOrderState());
+}
+
 TEST_P(GameInterfaceTest, setLoadOrderShouldSetTheLoadOrder) {
   // Remove the non-ASCII duplicate plugin.
   std::filesystem::remove(dataPath / std::filesystem::u8path(nonAsciiEsm));
@@ -104,6 +104,25 @@ impl std::fmt::Display for UnsupportedEnumValueError {
 
 impl std::error::Error for UnsupportedEnumValueError {}
 
+/// Indicates that the lock that a wrapper uses to share a game handle between
+/// threads has been poisoned, so the game handle may be in an invalid state.
+#[derive(Clone, Copy, Debug, Default, Eq, PartialEq, Ord, PartialOrd, Hash)]
+pub struct GameLockPoisonError;
+
+impl std::fmt::Display for GameLockPoisonError {
+    fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
+        write!(f, "the game's lock has been poisoned")
+    }
+}
+
+impl std::error::Error for GameLockPoisonError {}
+
+impl<T> From<std::sync::PoisonError<T>> for GameLockPoisonError {
+    fn from(_: std::sync::PoisonError<T>) -> Self {
+        GameLockPoisonError
+    }
+}
+
 pub fn fmt_error_chain(
     mut error: &dyn std::error::Error,
     f: &mut std::fmt::Formatter<'_>,
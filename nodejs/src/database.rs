@@ -1,14 +1,15 @@
 use std::{
     path::Path,
-    sync::{Arc, RwLock},
+    sync::{Arc, RwLock, RwLockReadGuard, RwLockWriteGuard, TryLockError},
 };
 
 use libloot::{error::DatabaseLockPoisonError, WriteMode};
 use libloot_ffi_errors::UnsupportedEnumValueError;
+use napi::{bindgen_prelude::AsyncTask, Env, Task};
 use napi_derive::napi;
 
 use crate::{
-    error::VerboseError,
+    error::{DatabaseInUseError, VerboseError},
     metadata::{Group, Message, PluginMetadata},
 };
 
@@ -20,35 +21,66 @@ pub struct Database(Arc<RwLock<libloot::Database>>);
 impl Database {
     #[napi]
     pub fn load_masterlist(&self, path: String) -> Result<(), VerboseError> {
-        self.0
-            .write()
-            .map_err(DatabaseLockPoisonError::from)?
+        self.write()?
             .load_masterlist(Path::new(&path))
             .map_err(Into::into)
     }
 
+    /// Like `loadMasterlist()`, but runs on the libuv thread pool and returns
+    /// a promise.
+    #[napi]
+    pub fn load_masterlist_async(&self, path: String) -> AsyncTask<LoadMetadataTask> {
+        AsyncTask::new(LoadMetadataTask {
+            database: Arc::clone(&self.0),
+            source: MetadataSource::Masterlist(path),
+        })
+    }
+
     #[napi]
     pub fn load_masterlist_with_prelude(
         &self,
         masterlist_path: String,
         prelude_path: String,
     ) -> Result<(), VerboseError> {
-        self.0
-            .write()
-            .map_err(DatabaseLockPoisonError::from)?
+        self.write()?
             .load_masterlist_with_prelude(Path::new(&masterlist_path), Path::new(&prelude_path))
             .map_err(Into::into)
     }
 
+    /// Like `loadMasterlistWithPrelude()`, but runs on the libuv thread pool
+    /// and returns a promise.
+    #[napi]
+    pub fn load_masterlist_with_prelude_async(
+        &self,
+        masterlist_path: String,
+        prelude_path: String,
+    ) -> AsyncTask<LoadMetadataTask> {
+        AsyncTask::new(LoadMetadataTask {
+            database: Arc::clone(&self.0),
+            source: MetadataSource::MasterlistWithPrelude {
+                masterlist_path,
+                prelude_path,
+            },
+        })
+    }
+
     #[napi]
     pub fn load_userlist(&self, path: String) -> Result<(), VerboseError> {
-        self.0
-            .write()
-            .map_err(DatabaseLockPoisonError::from)?
+        self.write()?
             .load_userlist(Path::new(&path))
             .map_err(Into::into)
     }
 
+    /// Like `loadUserlist()`, but runs on the libuv thread pool and returns a
+    /// promise.
+    #[napi]
+    pub fn load_userlist_async(&self, path: String) -> AsyncTask<LoadMetadataTask> {
+        AsyncTask::new(LoadMetadataTask {
+            database: Arc::clone(&self.0),
+            source: MetadataSource::Userlist(path),
+        })
+    }
+
     #[napi]
     pub fn write_user_metadata(
         &self,
@@ -61,9 +93,7 @@ impl Database {
             WriteMode::Create
         };
 
-        self.0
-            .read()
-            .map_err(DatabaseLockPoisonError::from)?
+        self.read()?
             .write_user_metadata(Path::new(&output_path), write_mode)
             .map_err(Into::into)
     }
@@ -80,29 +110,19 @@ impl Database {
             WriteMode::Create
         };
 
-        self.0
-            .read()
-            .map_err(DatabaseLockPoisonError::from)?
+        self.read()?
             .write_minimal_list(Path::new(&output_path), write_mode)
             .map_err(Into::into)
     }
 
     #[napi]
     pub fn evaluate(&self, condition: String) -> Result<bool, VerboseError> {
-        self.0
-            .read()
-            .map_err(DatabaseLockPoisonError::from)?
-            .evaluate(&condition)
-            .map_err(Into::into)
+        self.read()?.evaluate(&condition).map_err(Into::into)
     }
 
     #[napi]
     pub fn known_bash_tags(&self) -> Result<Vec<String>, VerboseError> {
-        Ok(self
-            .0
-            .read()
-            .map_err(DatabaseLockPoisonError::from)?
-            .known_bash_tags())
+        Ok(self.read()?.known_bash_tags())
     }
 
     #[napi]
@@ -110,9 +130,7 @@ impl Database {
         &self,
         evaluate_conditions: bool,
     ) -> Result<Vec<Message>, VerboseError> {
-        self.0
-            .write()
-            .map_err(DatabaseLockPoisonError::from)?
+        self.write()?
             .general_messages(evaluate_conditions)
             .map(|v| v.into_iter().map(Into::into).collect())
             .map_err(Into::into)
@@ -121,9 +139,7 @@ impl Database {
     #[napi]
     pub fn groups(&self, include_user_metadata: bool) -> Result<Vec<Group>, VerboseError> {
         Ok(self
-            .0
-            .read()
-            .map_err(DatabaseLockPoisonError::from)?
+            .read()?
             .groups(include_user_metadata)
             .into_iter()
             .map(Into::into)
@@ -133,9 +149,7 @@ impl Database {
     #[napi]
     pub fn user_groups(&self) -> Result<Vec<Group>, VerboseError> {
         Ok(self
-            .0
-            .read()
-            .map_err(DatabaseLockPoisonError::from)?
+            .read()?
             .user_groups()
             .iter()
             .cloned()
@@ -146,10 +160,7 @@ impl Database {
     #[napi]
     pub fn set_user_groups(&self, groups: Vec<&Group>) -> Result<(), VerboseError> {
         let groups = groups.into_iter().cloned().map(Into::into).collect();
-        self.0
-            .write()
-            .map_err(DatabaseLockPoisonError::from)?
-            .set_user_groups(groups);
+        self.write()?.set_user_groups(groups);
         Ok(())
     }
 
@@ -159,9 +170,7 @@ impl Database {
         from_group_name: String,
         to_group_name: String,
     ) -> Result<Vec<Vertex>, VerboseError> {
-        self.0
-            .read()
-            .map_err(DatabaseLockPoisonError::from)?
+        self.read()?
             .groups_path(&from_group_name, &to_group_name)
             .map(|v| v.into_iter().map(Into::into).collect())
             .map_err(Into::into)
@@ -174,9 +183,7 @@ impl Database {
         include_user_metadata: bool,
         evaluate_conditions: bool,
     ) -> Result<Option<PluginMetadata>, VerboseError> {
-        self.0
-            .read()
-            .map_err(DatabaseLockPoisonError::from)?
+        self.read()?
             .plugin_metadata(&plugin_name, include_user_metadata, evaluate_conditions)
             .map(|p| p.map(Into::into))
             .map_err(Into::into)
@@ -188,9 +195,7 @@ impl Database {
         plugin_name: String,
         evaluate_conditions: bool,
     ) -> Result<Option<PluginMetadata>, VerboseError> {
-        self.0
-            .read()
-            .map_err(DatabaseLockPoisonError::from)?
+        self.read()?
             .plugin_user_metadata(&plugin_name, evaluate_conditions)
             .map(|p| p.map(Into::into))
             .map_err(Into::into)
@@ -201,30 +206,99 @@ impl Database {
         &mut self,
         plugin_metadata: &PluginMetadata,
     ) -> Result<(), VerboseError> {
-        self.0
-            .write()
-            .map_err(DatabaseLockPoisonError::from)?
+        self.write()?
             .set_plugin_user_metadata(plugin_metadata.clone().into());
         Ok(())
     }
 
     #[napi]
     pub fn discard_plugin_user_metadata(&self, plugin: String) -> Result<(), VerboseError> {
-        self.0
-            .write()
-            .map_err(DatabaseLockPoisonError::from)?
-            .discard_plugin_user_metadata(&plugin);
+        self.write()?.discard_plugin_user_metadata(&plugin);
         Ok(())
     }
 
     #[napi]
     pub fn discard_all_user_metadata(&self) -> Result<(), VerboseError> {
-        self.0
-            .write()
-            .map_err(DatabaseLockPoisonError::from)?
-            .discard_all_user_metadata();
+        self.write()?.discard_all_user_metadata();
         Ok(())
     }
+
+    fn read(&self) -> Result<RwLockReadGuard<'_, libloot::Database>, VerboseError> {
+        self.0.try_read().map_err(try_lock_error)
+    }
+
+    fn write(&self) -> Result<RwLockWriteGuard<'_, libloot::Database>, VerboseError> {
+        self.0.try_write().map_err(try_lock_error)
+    }
+}
+
+#[derive(Debug)]
+enum MetadataSource {
+    Masterlist(String),
+    MasterlistWithPrelude {
+        masterlist_path: String,
+        prelude_path: String,
+    },
+    Userlist(String),
+}
+
+/// Loads metadata on the libuv thread pool. The database's lock is held while
+/// the metadata is loaded, so overlapping loads and other calls that use the
+/// database run one after another.
+#[derive(Debug)]
+pub struct LoadMetadataTask {
+    database: Arc<RwLock<libloot::Database>>,
+    source: MetadataSource,
+}
+
+impl Task for LoadMetadataTask {
+    type Output = ();
+    type JsValue = ();
+
+    fn compute(&mut self) -> napi::Result<Self::Output> {
+        let mut database = self
+            .database
+            .write()
+            .map_err(|e| VerboseError::from(DatabaseLockPoisonError::from(e)))?;
+
+        let result = match &self.source {
+            MetadataSource::Masterlist(path) => database.load_masterlist(Path::new(path)),
+            MetadataSource::MasterlistWithPrelude {
+                masterlist_path,
+                prelude_path,
+            } => database
+                .load_masterlist_with_prelude(Path::new(masterlist_path), Path::new(prelude_path)),
+            MetadataSource::Userlist(path) => database.load_userlist(Path::new(path)),
+        };
+
+        result.map_err(|e| VerboseError::from(e).into())
+    }
+
+    fn resolve(&mut self, _: Env, output: Self::Output) -> napi::Result<Self::JsValue> {
+        Ok(output)
+    }
+}
+
+/// Fail instead of blocking if an async call is using the given database in a
+/// way that conflicts with a shared or exclusive lock. The lock isn't held once
+/// this returns, as libloot takes it itself, so this guards synchronous game
+/// calls that take the game's database lock internally.
+pub fn check_database_is_not_in_use(
+    database: &RwLock<libloot::Database>,
+    exclusive: bool,
+) -> Result<(), VerboseError> {
+    if exclusive {
+        database.try_write().map(drop).map_err(try_lock_error)
+    } else {
+        database.try_read().map(drop).map_err(try_lock_error)
+    }
+}
+
+fn try_lock_error<T>(error: TryLockError<T>) -> VerboseError {
+    match error {
+        TryLockError::Poisoned(e) => DatabaseLockPoisonError::from(e).into(),
+        TryLockError::WouldBlock => DatabaseInUseError.into(),
+    }
 }
 
 impl From<Arc<RwLock<libloot::Database>>> for Database {
@@ -1,3 +1,5 @@
+use std::num::TryFromIntError;
+
 use libloot::{
     error::{
         ConditionEvaluationError, DatabaseLockPoisonError, GameHandleCreationError,
@@ -8,7 +10,7 @@ use libloot::{
         LoadMetadataError, MultilingualMessageContentsError, RegexError, WriteMetadataError,
     },
 };
-use libloot_ffi_errors::{fmt_error_chain, UnsupportedEnumValueError};
+use libloot_ffi_errors::{fmt_error_chain, GameLockPoisonError, UnsupportedEnumValueError};
 
 #[derive(Debug)]
 pub struct VerboseError(Box<dyn std::error::Error>);
@@ -19,6 +21,32 @@ impl std::fmt::Display for VerboseError {
     }
 }
 
+/// Indicates that a synchronous call was made while an async call was using the
+/// same game handle, so waiting for it would block the event loop.
+#[derive(Clone, Copy, Debug, Default, Eq, PartialEq, Ord, PartialOrd, Hash)]
+pub struct GameInUseError;
+
+impl std::fmt::Display for GameInUseError {
+    fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
+        write!(f, "the game is in use by an async call")
+    }
+}
+
+impl std::error::Error for GameInUseError {}
+
+/// Indicates that a synchronous call was made while an async call was using the
+/// same database, so waiting for it would block the event loop.
+#[derive(Clone, Copy, Debug, Default, Eq, PartialEq, Ord, PartialOrd, Hash)]
+pub struct DatabaseInUseError;
+
+impl std::fmt::Display for DatabaseInUseError {
+    fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
+        write!(f, "the database is in use by an async call")
+    }
+}
+
+impl std::error::Error for DatabaseInUseError {}
+
 macro_rules! box_from_error {
     ( $from_type:ident, $to_type:ident ) => {
         impl From<$from_type> for $to_type {
@@ -32,6 +60,9 @@ macro_rules! box_from_error {
 box_from_error!(GameHandleCreationError, VerboseError);
 box_from_error!(UnsupportedEnumValueError, VerboseError);
 box_from_error!(DatabaseLockPoisonError, VerboseError);
+box_from_error!(GameLockPoisonError, VerboseError);
+box_from_error!(GameInUseError, VerboseError);
+box_from_error!(DatabaseInUseError, VerboseError);
 box_from_error!(LoadPluginsError, VerboseError);
 box_from_error!(SortPluginsError, VerboseError);
 box_from_error!(LoadOrderStateError, VerboseError);
@@ -44,6 +75,7 @@ box_from_error!(MetadataRetrievalError, VerboseError);
 box_from_error!(MultilingualMessageContentsError, VerboseError);
 box_from_error!(RegexError, VerboseError);
 box_from_error!(PluginDataError, VerboseError);
+box_from_error!(TryFromIntError, VerboseError);
 
 impl From<VerboseError> for napi::Error {
     fn from(value: VerboseError) -> Self {
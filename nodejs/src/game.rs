@@ -1,9 +1,20 @@
-use std::path::Path;
+use std::{
+    path::Path,
+    sync::{Arc, RwLock, RwLockReadGuard, RwLockWriteGuard, TryLockError},
+};
 
-use libloot_ffi_errors::UnsupportedEnumValueError;
+use libloot_ffi_errors::{GameLockPoisonError, UnsupportedEnumValueError};
+use napi::{
+    bindgen_prelude::{AsyncTask, Buffer},
+    Env, Task,
+};
 use napi_derive::napi;
 
-use crate::{database::Database, error::VerboseError, plugin::Plugin};
+use crate::{
+    database::{check_database_is_not_in_use, Database},
+    error::{GameInUseError, VerboseError},
+    plugin::Plugin,
+};
 
 #[napi]
 #[derive(Debug, Eq, PartialEq, Ord, PartialOrd, Hash)]
@@ -63,9 +74,16 @@ impl From<GameType> for libloot::GameType {
     }
 }
 
+/// The game handle is shared with any async tasks that are running on the
+/// libuv thread pool. Calls that modify the game's state take an exclusive
+/// lock and calls that only read it take a shared lock, so overlapping async
+/// tasks run one after another, except for reads, which can run concurrently.
+/// Synchronous calls don't wait for the lock, as that would block the event
+/// loop: if an async task is using the game in a way that conflicts with the
+/// call, it fails with a [GameInUseError] instead.
 #[napi]
 #[derive(Debug)]
-pub struct Game(libloot::Game);
+pub struct Game(Arc<RwLock<libloot::Game>>);
 
 #[napi]
 impl Game {
@@ -75,119 +93,251 @@ impl Game {
         game_path: String,
         local_path: Option<String>,
     ) -> Result<Self, VerboseError> {
-        match local_path {
-            Some(local_path) => Ok(Game(libloot::Game::with_local_path(
+        let game = match local_path {
+            Some(local_path) => libloot::Game::with_local_path(
                 game_type.into(),
                 Path::new(&game_path),
                 Path::new(&local_path),
-            )?)),
-            None => Ok(Game(libloot::Game::new(
-                game_type.into(),
-                Path::new(&game_path),
-            )?)),
-        }
+            )?,
+            None => libloot::Game::new(game_type.into(), Path::new(&game_path))?,
+        };
+
+        Ok(Game(Arc::new(RwLock::new(game))))
     }
 
     #[napi]
     pub fn game_type(&self) -> Result<GameType, VerboseError> {
-        self.0.game_type().try_into().map_err(Into::into)
+        self.read()?.game_type().try_into().map_err(Into::into)
     }
 
     #[napi]
-    pub fn additional_data_paths(&self) -> Vec<String> {
-        self.0
+    pub fn additional_data_paths(&self) -> Result<Vec<String>, VerboseError> {
+        Ok(self
+            .read()?
             .additional_data_paths()
             .iter()
             .map(|p| p.to_string_lossy().to_string())
-            .collect()
+            .collect())
     }
 
     #[napi]
     pub fn set_additional_data_paths(&mut self, paths: Vec<String>) -> Result<(), VerboseError> {
-        self.0.set_additional_data_paths(&as_paths(&paths))?;
+        let mut game = self.write()?;
+        check_database_is_not_in_use(&game.database(), true)?;
+        game.set_additional_data_paths(&as_paths(&paths))?;
         Ok(())
     }
 
     #[napi]
-    pub fn database(&self) -> Database {
-        self.0.database().into()
+    pub fn database(&self) -> Result<Database, VerboseError> {
+        Ok(self.read()?.database().into())
     }
 
     #[napi]
-    pub fn is_valid_plugin(&self, plugin_path: String) -> bool {
-        self.0.is_valid_plugin(Path::new(&plugin_path))
+    pub fn is_valid_plugin(&self, plugin_path: String) -> Result<bool, VerboseError> {
+        Ok(self.read()?.is_valid_plugin(Path::new(&plugin_path)))
     }
 
     #[napi]
     pub fn load_plugins(&mut self, plugin_paths: Vec<String>) -> Result<(), VerboseError> {
-        self.0.load_plugins(&as_paths(&plugin_paths))?;
+        let mut game = self.write()?;
+        check_database_is_not_in_use(&game.database(), true)?;
+        game.load_plugins(&as_paths(&plugin_paths))?;
         Ok(())
     }
 
+    /// Like `loadPlugins()`, but runs on the libuv thread pool and returns a
+    /// promise.
+    #[napi]
+    pub fn load_plugins_async(&self, plugin_paths: Vec<String>) -> AsyncTask<LoadPluginsTask> {
+        AsyncTask::new(LoadPluginsTask {
+            game: Arc::clone(&self.0),
+            plugin_paths,
+            headers_only: false,
+        })
+    }
+
     #[napi]
     pub fn load_plugin_headers(&mut self, plugin_paths: Vec<String>) -> Result<(), VerboseError> {
-        self.0.load_plugin_headers(&as_paths(&plugin_paths))?;
+        let mut game = self.write()?;
+        check_database_is_not_in_use(&game.database(), true)?;
+        game.load_plugin_headers(&as_paths(&plugin_paths))?;
         Ok(())
     }
 
+    /// Like `loadPluginHeaders()`, but runs on the libuv thread pool and
+    /// returns a promise.
+    #[napi]
+    pub fn load_plugin_headers_async(
+        &self,
+        plugin_paths: Vec<String>,
+    ) -> AsyncTask<LoadPluginsTask> {
+        AsyncTask::new(LoadPluginsTask {
+            game: Arc::clone(&self.0),
+            plugin_paths,
+            headers_only: true,
+        })
+    }
+
     #[napi]
-    pub fn clear_loaded_plugins(&mut self) {
-        self.0.clear_loaded_plugins();
+    pub fn clear_loaded_plugins(&mut self) -> Result<(), VerboseError> {
+        self.write()?.clear_loaded_plugins();
+        Ok(())
     }
 
     #[napi]
-    pub fn plugin(&self, plugin_name: String) -> Option<Plugin> {
-        self.0.plugin(&plugin_name).map(Into::into)
+    pub fn plugin(&self, plugin_name: String) -> Result<Option<Plugin>, VerboseError> {
+        Ok(self.read()?.plugin(&plugin_name).map(Into::into))
     }
 
     #[napi]
-    pub fn loaded_plugins(&self) -> Vec<Plugin> {
-        self.0
+    pub fn loaded_plugins(&self) -> Result<Vec<Plugin>, VerboseError> {
+        Ok(self
+            .read()?
             .loaded_plugins()
             .into_iter()
             .map(Into::into)
-            .collect()
+            .collect())
+    }
+
+    /// Get a summary of all loaded plugins packed into a single buffer, which
+    /// avoids creating an object for each plugin. See the README for the
+    /// buffer's layout. If includeCrcs is true, any CRCs that have not yet been
+    /// calculated are calculated in parallel.
+    #[napi]
+    pub fn loaded_plugin_summaries(
+        &self,
+        include_crcs: Option<bool>,
+    ) -> Result<Buffer, VerboseError> {
+        let include_crcs = include_crcs.unwrap_or(false);
+
+        Ok(self.read()?.loaded_plugin_summaries(include_crcs)?.into())
     }
 
     #[napi]
     pub fn sort_plugins(&self, plugin_names: Vec<String>) -> Result<Vec<String>, VerboseError> {
-        Ok(self.0.sort_plugins(&as_strs(&plugin_names))?)
+        let game = self.read()?;
+        check_database_is_not_in_use(&game.database(), false)?;
+        Ok(game.sort_plugins(&as_strs(&plugin_names))?)
+    }
+
+    /// Like `sortPlugins()`, but runs on the libuv thread pool and returns a
+    /// promise.
+    #[napi]
+    pub fn sort_plugins_async(&self, plugin_names: Vec<String>) -> AsyncTask<SortPluginsTask> {
+        AsyncTask::new(SortPluginsTask {
+            game: Arc::clone(&self.0),
+            plugin_names,
+        })
     }
 
     #[napi]
     pub fn load_current_load_order_state(&mut self) -> Result<(), VerboseError> {
-        self.0.load_current_load_order_state()?;
+        let mut game = self.write()?;
+        check_database_is_not_in_use(&game.database(), true)?;
+        game.load_current_load_order_state()?;
         Ok(())
     }
 
     #[napi]
     pub fn is_load_order_ambiguous(&self) -> Result<bool, VerboseError> {
-        Ok(self.0.is_load_order_ambiguous()?)
+        Ok(self.read()?.is_load_order_ambiguous()?)
     }
 
     #[napi]
-    pub fn active_plugins_file_path(&self) -> String {
-        self.0
+    pub fn active_plugins_file_path(&self) -> Result<String, VerboseError> {
+        Ok(self
+            .read()?
             .active_plugins_file_path()
             .to_string_lossy()
-            .to_string()
+            .to_string())
     }
 
     #[napi]
-    pub fn is_plugin_active(&self, plugin_name: String) -> bool {
-        self.0.is_plugin_active(&plugin_name)
+    pub fn is_plugin_active(&self, plugin_name: String) -> Result<bool, VerboseError> {
+        Ok(self.read()?.is_plugin_active(&plugin_name))
     }
 
     #[napi]
-    pub fn load_order(&self) -> Vec<&str> {
-        self.0.load_order()
+    pub fn load_order(&self) -> Result<Vec<String>, VerboseError> {
+        Ok(self.read()?.load_order().to_vec())
     }
 
     #[napi]
     pub fn set_load_order(&mut self, load_order: Vec<String>) -> Result<(), VerboseError> {
-        self.0.set_load_order(&as_strs(&load_order))?;
+        self.write()?.set_load_order(&as_strs(&load_order))?;
         Ok(())
     }
+
+    fn read(&self) -> Result<RwLockReadGuard<'_, libloot::Game>, VerboseError> {
+        self.0.try_read().map_err(try_lock_error)
+    }
+
+    fn write(&self) -> Result<RwLockWriteGuard<'_, libloot::Game>, VerboseError> {
+        self.0.try_write().map_err(try_lock_error)
+    }
+}
+
+#[derive(Debug)]
+pub struct LoadPluginsTask {
+    game: Arc<RwLock<libloot::Game>>,
+    plugin_paths: Vec<String>,
+    headers_only: bool,
+}
+
+impl Task for LoadPluginsTask {
+    type Output = ();
+    type JsValue = ();
+
+    fn compute(&mut self) -> napi::Result<Self::Output> {
+        let mut game = self
+            .game
+            .write()
+            .map_err(|e| VerboseError::from(GameLockPoisonError::from(e)))?;
+        let plugin_paths = as_paths(&self.plugin_paths);
+
+        let result = if self.headers_only {
+            game.load_plugin_headers(&plugin_paths)
+        } else {
+            game.load_plugins(&plugin_paths)
+        };
+
+        result.map_err(|e| VerboseError::from(e).into())
+    }
+
+    fn resolve(&mut self, _: Env, output: Self::Output) -> napi::Result<Self::JsValue> {
+        Ok(output)
+    }
+}
+
+#[derive(Debug)]
+pub struct SortPluginsTask {
+    game: Arc<RwLock<libloot::Game>>,
+    plugin_names: Vec<String>,
+}
+
+impl Task for SortPluginsTask {
+    type Output = Vec<String>;
+    type JsValue = Vec<String>;
+
+    fn compute(&mut self) -> napi::Result<Self::Output> {
+        self.game
+            .read()
+            .map_err(|e| VerboseError::from(GameLockPoisonError::from(e)))?
+            .sort_plugins(&as_strs(&self.plugin_names))
+            .map_err(|e| VerboseError::from(e).into())
+    }
+
+    fn resolve(&mut self, _: Env, output: Self::Output) -> napi::Result<Self::JsValue> {
+        Ok(output)
+    }
+}
+
+fn try_lock_error<T>(error: TryLockError<T>) -> VerboseError {
+    match error {
+        TryLockError::Poisoned(e) => GameLockPoisonError::from(e).into(),
+        TryLockError::WouldBlock => GameInUseError.into(),
+    }
 }
 
 fn as_paths(pathbufs: &[String]) -> Vec<&Path> {
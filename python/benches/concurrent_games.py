@@ -0,0 +1,74 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+"""Measures how well loading and sorting plugins scales across threads.
+
+Each thread creates its own game handle for the given game install, loads its
+current load order state and all its plugins, then sorts them. The same work
+is first run sequentially on one thread and then concurrently on the given
+numbers of threads, so if the GIL is released while libloot is working, the
+concurrent runs should take much less time than running the same number of
+handles sequentially.
+
+Build the wrapper in release mode first, e.g. using `maturin develop --release`.
+"""
+
+import argparse
+import concurrent.futures
+import time
+
+import loot
+
+
+def load_and_sort(game_type, game_path, local_path, masterlist_path):
+    game = loot.Game(game_type, game_path, local_path)
+
+    if masterlist_path:
+        game.database().load_masterlist(masterlist_path)
+
+    game.load_current_load_order_state()
+
+    load_order = game.load_order()
+    game.load_plugins(load_order)
+    game.sort_plugins(load_order)
+
+
+def run(thread_count, handle_count, args):
+    start = time.perf_counter()
+
+    with concurrent.futures.ThreadPoolExecutor(max_workers=thread_count) as executor:
+        futures = [
+            executor.submit(load_and_sort, args.game_type, args.game_path,
+                            args.local_path, args.masterlist)
+            for _ in range(handle_count)
+        ]
+        for future in futures:
+            future.result()
+
+    return time.perf_counter() - start
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(description = 'Measure the scaling of concurrent game handles')
+    parser.add_argument('game_type', help = 'The type of game to load, e.g. SkyrimSE')
+    parser.add_argument('game_path', help = 'The path to the game\'s install directory')
+    parser.add_argument('--local-path', dest = 'local_path', help = 'The path to the game\'s local app data directory')
+    parser.add_argument('--masterlist', help = 'The path to a masterlist to load before sorting')
+    parser.add_argument('--threads', type = int, nargs = '+', default = [2, 4, 8], help = 'The numbers of threads to test')
+
+    args = parser.parse_args()
+    args.game_type = getattr(loot.GameType, args.game_type)
+
+    # Warm up the filesystem cache so that the first run isn't penalised.
+    run(1, 1, args)
+
+    baseline = run(1, 1, args)
+    print('1 handle on 1 thread: {:.3f}s'.format(baseline))
+
+    for thread_count in args.threads:
+        sequential = run(1, thread_count, args)
+        concurrent = run(thread_count, thread_count, args)
+        speedup = sequential / concurrent
+
+        print('{0} handles on 1 thread: {1:.3f}s, on {0} threads: {2:.3f}s, speedup: {3:.2f}x'.format(
+            thread_count, sequential, concurrent, speedup))
@@ -6,15 +6,21 @@ use std::{
 use libloot::{WriteMode, error::DatabaseLockPoisonError};
 use libloot_ffi_errors::UnsupportedEnumValueError;
 use pyo3::{
-    Bound, PyResult, pyclass, pymethods,
+    Bound, PyResult, Python,
+    marker::Ungil,
+    pyclass, pymethods,
     types::{PyAnyMethods, PyTypeMethods},
 };
 
 use crate::{
     error::VerboseError,
+    lock,
     metadata::{Group, Message, NONE_REPR, PluginMetadata},
 };
 
+/// The database is shared with the game handle that it was obtained from. Like
+/// the game handle, its lock is only ever taken with the GIL released: see
+/// [lock::read] for why.
 #[pyclass]
 #[derive(Clone, Debug)]
 pub struct Database(Arc<RwLock<libloot::Database>>);
@@ -22,39 +28,32 @@ pub struct Database(Arc<RwLock<libloot::Database>>);
 #[pymethods]
 impl Database {
     #[expect(clippy::needless_pass_by_value, reason = "Required by PyO3")]
-    pub fn load_masterlist(&self, path: PathBuf) -> Result<(), VerboseError> {
-        self.0
-            .write()
-            .map_err(DatabaseLockPoisonError::from)?
-            .load_masterlist(&path)
-            .map_err(Into::into)
+    pub fn load_masterlist(&self, py: Python<'_>, path: PathBuf) -> Result<(), VerboseError> {
+        write_database(py, &self.0, |database| database.load_masterlist(&path))?.map_err(Into::into)
     }
 
     #[expect(clippy::needless_pass_by_value, reason = "Required by PyO3")]
     pub fn load_masterlist_with_prelude(
         &self,
+        py: Python<'_>,
         masterlist_path: PathBuf,
         prelude_path: PathBuf,
     ) -> Result<(), VerboseError> {
-        self.0
-            .write()
-            .map_err(DatabaseLockPoisonError::from)?
-            .load_masterlist_with_prelude(&masterlist_path, &prelude_path)
-            .map_err(Into::into)
+        write_database(py, &self.0, |database| {
+            database.load_masterlist_with_prelude(&masterlist_path, &prelude_path)
+        })?
+        .map_err(Into::into)
     }
 
     #[expect(clippy::needless_pass_by_value, reason = "Required by PyO3")]
-    pub fn load_userlist(&self, path: PathBuf) -> Result<(), VerboseError> {
-        self.0
-            .write()
-            .map_err(DatabaseLockPoisonError::from)?
-            .load_userlist(&path)
-            .map_err(Into::into)
+    pub fn load_userlist(&self, py: Python<'_>, path: PathBuf) -> Result<(), VerboseError> {
+        write_database(py, &self.0, |database| database.load_userlist(&path))?.map_err(Into::into)
     }
 
     #[expect(clippy::needless_pass_by_value, reason = "Required by PyO3")]
     pub fn write_user_metadata(
         &self,
+        py: Python<'_>,
         output_path: PathBuf,
         overwrite: bool,
     ) -> Result<(), VerboseError> {
@@ -64,16 +63,16 @@ impl Database {
             WriteMode::Create
         };
 
-        self.0
-            .read()
-            .map_err(DatabaseLockPoisonError::from)?
-            .write_user_metadata(&output_path, write_mode)
-            .map_err(Into::into)
+        read_database(py, &self.0, |database| {
+            database.write_user_metadata(&output_path, write_mode)
+        })?
+        .map_err(Into::into)
     }
 
     #[expect(clippy::needless_pass_by_value, reason = "Required by PyO3")]
     pub fn write_minimal_list(
         &self,
+        py: Python<'_>,
         output_path: PathBuf,
         overwrite: bool,
     ) -> Result<(), VerboseError> {
@@ -83,141 +82,149 @@ impl Database {
             WriteMode::Create
         };
 
-        self.0
-            .read()
-            .map_err(DatabaseLockPoisonError::from)?
-            .write_minimal_list(&output_path, write_mode)
-            .map_err(Into::into)
+        read_database(py, &self.0, |database| {
+            database.write_minimal_list(&output_path, write_mode)
+        })?
+        .map_err(Into::into)
     }
 
-    pub fn evaluate(&self, condition: &str) -> Result<bool, VerboseError> {
-        self.0
-            .read()
-            .map_err(DatabaseLockPoisonError::from)?
-            .evaluate(condition)
-            .map_err(Into::into)
+    pub fn evaluate(&self, py: Python<'_>, condition: &str) -> Result<bool, VerboseError> {
+        read_database(py, &self.0, |database| database.evaluate(condition))?.map_err(Into::into)
     }
 
-    pub fn known_bash_tags(&self) -> Result<Vec<String>, VerboseError> {
-        Ok(self
-            .0
-            .read()
-            .map_err(DatabaseLockPoisonError::from)?
-            .known_bash_tags())
+    pub fn known_bash_tags(&self, py: Python<'_>) -> Result<Vec<String>, VerboseError> {
+        Ok(read_database(
+            py,
+            &self.0,
+            libloot::Database::known_bash_tags,
+        )?)
     }
 
     pub fn general_messages(
         &self,
+        py: Python<'_>,
         evaluate_conditions: bool,
     ) -> Result<Vec<Message>, VerboseError> {
-        self.0
-            .write()
-            .map_err(DatabaseLockPoisonError::from)?
-            .general_messages(evaluate_conditions)
-            .map(|v| v.into_iter().map(Into::into).collect())
-            .map_err(Into::into)
+        write_database(py, &self.0, |database| {
+            database.general_messages(evaluate_conditions)
+        })?
+        .map(|v| v.into_iter().map(Into::into).collect())
+        .map_err(Into::into)
     }
 
-    pub fn groups(&self, include_user_metadata: bool) -> Result<Vec<Group>, VerboseError> {
-        Ok(self
-            .0
-            .read()
-            .map_err(DatabaseLockPoisonError::from)?
-            .groups(include_user_metadata)
-            .into_iter()
-            .map(Into::into)
-            .collect())
+    pub fn groups(
+        &self,
+        py: Python<'_>,
+        include_user_metadata: bool,
+    ) -> Result<Vec<Group>, VerboseError> {
+        Ok(read_database(py, &self.0, |database| {
+            database.groups(include_user_metadata)
+        })?
+        .into_iter()
+        .map(Into::into)
+        .collect())
     }
 
-    fn user_groups(&self) -> Result<Vec<Group>, VerboseError> {
-        Ok(self
-            .0
-            .read()
-            .map_err(DatabaseLockPoisonError::from)?
-            .user_groups()
-            .iter()
-            .cloned()
-            .map(Into::into)
-            .collect())
+    fn user_groups(&self, py: Python<'_>) -> Result<Vec<Group>, VerboseError> {
+        Ok(
+            read_database(py, &self.0, |database| database.user_groups().to_vec())?
+                .into_iter()
+                .map(Into::into)
+                .collect(),
+        )
     }
 
-    pub fn set_user_groups(&self, groups: Vec<Group>) -> Result<(), VerboseError> {
+    pub fn set_user_groups(&self, py: Python<'_>, groups: Vec<Group>) -> Result<(), VerboseError> {
         let groups = groups.into_iter().map(Into::into).collect();
-        self.0
-            .write()
-            .map_err(DatabaseLockPoisonError::from)?
-            .set_user_groups(groups);
+        write_database(py, &self.0, |database| database.set_user_groups(groups))?;
         Ok(())
     }
 
     pub fn groups_path(
         &self,
+        py: Python<'_>,
         from_group_name: &str,
         to_group_name: &str,
     ) -> Result<Vec<Vertex>, VerboseError> {
-        self.0
-            .read()
-            .map_err(DatabaseLockPoisonError::from)?
-            .groups_path(from_group_name, to_group_name)
-            .map(|v| v.into_iter().map(Into::into).collect())
-            .map_err(Into::into)
+        read_database(py, &self.0, |database| {
+            database.groups_path(from_group_name, to_group_name)
+        })?
+        .map(|v| v.into_iter().map(Into::into).collect())
+        .map_err(Into::into)
     }
 
     pub fn plugin_metadata(
         &self,
+        py: Python<'_>,
         plugin_name: &str,
         include_user_metadata: bool,
         evaluate_conditions: bool,
     ) -> Result<Option<PluginMetadata>, VerboseError> {
-        self.0
-            .read()
-            .map_err(DatabaseLockPoisonError::from)?
-            .plugin_metadata(plugin_name, include_user_metadata, evaluate_conditions)
-            .map(|p| p.map(Into::into))
-            .map_err(Into::into)
+        read_database(py, &self.0, |database| {
+            database.plugin_metadata(plugin_name, include_user_metadata, evaluate_conditions)
+        })?
+        .map(|p| p.map(Into::into))
+        .map_err(Into::into)
     }
 
     pub fn plugin_user_metadata(
         &self,
+        py: Python<'_>,
         plugin_name: &str,
         evaluate_conditions: bool,
     ) -> Result<Option<PluginMetadata>, VerboseError> {
-        self.0
-            .read()
-            .map_err(DatabaseLockPoisonError::from)?
-            .plugin_user_metadata(plugin_name, evaluate_conditions)
-            .map(|p| p.map(Into::into))
-            .map_err(Into::into)
+        read_database(py, &self.0, |database| {
+            database.plugin_user_metadata(plugin_name, evaluate_conditions)
+        })?
+        .map(|p| p.map(Into::into))
+        .map_err(Into::into)
     }
 
     pub fn set_plugin_user_metadata(
         &mut self,
+        py: Python<'_>,
         plugin_metadata: PluginMetadata,
     ) -> Result<(), VerboseError> {
-        self.0
-            .write()
-            .map_err(DatabaseLockPoisonError::from)?
-            .set_plugin_user_metadata(plugin_metadata.into());
+        let plugin_metadata = plugin_metadata.into();
+        write_database(py, &self.0, |database| {
+            database.set_plugin_user_metadata(plugin_metadata);
+        })?;
         Ok(())
     }
 
-    pub fn discard_plugin_user_metadata(&self, plugin: &str) -> Result<(), VerboseError> {
-        self.0
-            .write()
-            .map_err(DatabaseLockPoisonError::from)?
-            .discard_plugin_user_metadata(plugin);
+    pub fn discard_plugin_user_metadata(
+        &self,
+        py: Python<'_>,
+        plugin: &str,
+    ) -> Result<(), VerboseError> {
+        write_database(py, &self.0, |database| {
+            database.discard_plugin_user_metadata(plugin);
+        })?;
         Ok(())
     }
 
-    pub fn discard_all_user_metadata(&self) -> Result<(), VerboseError> {
-        self.0
-            .write()
-            .map_err(DatabaseLockPoisonError::from)?
-            .discard_all_user_metadata();
+    pub fn discard_all_user_metadata(&self, py: Python<'_>) -> Result<(), VerboseError> {
+        write_database(py, &self.0, libloot::Database::discard_all_user_metadata)?;
         Ok(())
     }
 }
 
+fn read_database<R: Ungil>(
+    py: Python<'_>,
+    database: &RwLock<libloot::Database>,
+    f: impl FnOnce(&libloot::Database) -> R + Ungil,
+) -> Result<R, DatabaseLockPoisonError> {
+    lock::read(py, database, f)
+}
+
+fn write_database<R: Ungil>(
+    py: Python<'_>,
+    database: &RwLock<libloot::Database>,
+    f: impl FnOnce(&mut libloot::Database) -> R + Ungil,
+) -> Result<R, DatabaseLockPoisonError> {
+    lock::write(py, database, f)
+}
+
 impl From<Arc<RwLock<libloot::Database>>> for Database {
     fn from(value: Arc<RwLock<libloot::Database>>) -> Self {
         Self(value)
@@ -1,3 +1,5 @@
+use std::num::TryFromIntError;
+
 use libloot::{
     error::{
         ConditionEvaluationError, DatabaseLockPoisonError, GameHandleCreationError,
@@ -8,7 +10,9 @@ use libloot::{
         LoadMetadataError, MultilingualMessageContentsError, RegexError, WriteMetadataError,
     },
 };
-use libloot_ffi_errors::{UnsupportedEnumValueError, fmt_error_chain, variant_box_from_error};
+use libloot_ffi_errors::{
+    GameLockPoisonError, UnsupportedEnumValueError, fmt_error_chain, variant_box_from_error,
+};
 use pyo3::{PyErr, exceptions::PyValueError};
 
 use crate::{CyclicInteractionError, PluginNotLoadedError, UndefinedGroupError, database::Vertex};
@@ -34,6 +38,7 @@ impl std::fmt::Display for VerboseError {
 
 variant_box_from_error!(UnsupportedEnumValueError, VerboseError::Other);
 variant_box_from_error!(DatabaseLockPoisonError, VerboseError::Other);
+variant_box_from_error!(GameLockPoisonError, VerboseError::Other);
 variant_box_from_error!(LoadPluginsError, VerboseError::Other);
 variant_box_from_error!(LoadOrderError, VerboseError::Other);
 variant_box_from_error!(LoadMetadataError, VerboseError::Other);
@@ -45,6 +50,7 @@ variant_box_from_error!(GameHandleCreationError, VerboseError::Other);
 variant_box_from_error!(LoadOrderStateError, VerboseError::Other);
 variant_box_from_error!(MetadataRetrievalError, VerboseError::Other);
 variant_box_from_error!(PluginDataError, VerboseError::Other);
+variant_box_from_error!(TryFromIntError, VerboseError::Other);
 
 impl From<SortPluginsError> for VerboseError {
     fn from(value: SortPluginsError) -> Self {
@@ -1,9 +1,12 @@
-use std::path::{Path, PathBuf};
+use std::{
+    path::{Path, PathBuf},
+    sync::RwLock,
+};
 
-use libloot_ffi_errors::UnsupportedEnumValueError;
-use pyo3::{pyclass, pymethods};
+use libloot_ffi_errors::{GameLockPoisonError, UnsupportedEnumValueError};
+use pyo3::{Bound, Python, marker::Ungil, pyclass, pymethods, types::PyBytes};
 
-use crate::{database::Database, error::VerboseError, plugin::Plugin};
+use crate::{database::Database, error::VerboseError, lock, plugin::Plugin};
 
 #[pyclass(eq, frozen, hash, ord)]
 #[derive(Clone, Copy, Debug, Eq, PartialEq, Ord, PartialOrd, Hash)]
@@ -65,9 +68,14 @@ impl TryFrom<GameType> for libloot::GameType {
     }
 }
 
-#[pyclass]
+/// The game handle is wrapped in a lock so that calls that release the GIL
+/// can't run at the same time as other calls that use the same handle: instead,
+/// calls wait for the lock, with calls that modify the game's state taking an
+/// exclusive lock. The lock is only ever taken with the GIL released: see
+/// [lock::read] for why.
+#[pyclass(frozen)]
 #[derive(Debug)]
-pub struct Game(libloot::Game);
+pub struct Game(RwLock<libloot::Game>);
 
 #[pymethods]
 impl Game {
@@ -79,100 +87,170 @@ impl Game {
         game_path: PathBuf,
         local_path: Option<PathBuf>,
     ) -> Result<Self, VerboseError> {
-        match local_path {
-            Some(local_path) => Ok(Game(libloot::Game::with_local_path(
-                game_type.try_into()?,
-                &game_path,
-                &local_path,
-            )?)),
-            None => Ok(Game(libloot::Game::new(game_type.try_into()?, &game_path)?)),
-        }
+        let game = match local_path {
+            Some(local_path) => {
+                libloot::Game::with_local_path(game_type.try_into()?, &game_path, &local_path)?
+            }
+            None => libloot::Game::new(game_type.try_into()?, &game_path)?,
+        };
+
+        Ok(Game(RwLock::new(game)))
     }
 
-    fn game_type(&self) -> Result<GameType, VerboseError> {
-        self.0.game_type().try_into().map_err(Into::into)
+    fn game_type(&self, py: Python<'_>) -> Result<GameType, VerboseError> {
+        read_game(py, &self.0, libloot::Game::game_type)?
+            .try_into()
+            .map_err(Into::into)
     }
 
-    fn additional_data_paths(&self) -> &[PathBuf] {
-        self.0.additional_data_paths()
+    fn additional_data_paths(&self, py: Python<'_>) -> Result<Vec<PathBuf>, VerboseError> {
+        Ok(read_game(py, &self.0, |game| {
+            game.additional_data_paths().to_vec()
+        })?)
     }
 
     #[expect(clippy::needless_pass_by_value, reason = "Required by PyO3")]
-    fn set_additional_data_paths(&mut self, paths: Vec<PathBuf>) -> Result<(), VerboseError> {
-        self.0.set_additional_data_paths(&as_paths(&paths))?;
+    fn set_additional_data_paths(
+        &self,
+        py: Python<'_>,
+        paths: Vec<PathBuf>,
+    ) -> Result<(), VerboseError> {
+        write_game(py, &self.0, |game| {
+            game.set_additional_data_paths(&as_paths(&paths))
+        })??;
         Ok(())
     }
 
-    fn database(&self) -> Database {
-        self.0.database().into()
+    fn database(&self, py: Python<'_>) -> Result<Database, VerboseError> {
+        Ok(read_game(py, &self.0, libloot::Game::database)?.into())
     }
 
     #[expect(clippy::needless_pass_by_value, reason = "Required by PyO3")]
-    fn is_valid_plugin(&self, plugin_path: PathBuf) -> bool {
-        self.0.is_valid_plugin(&plugin_path)
+    fn is_valid_plugin(&self, py: Python<'_>, plugin_path: PathBuf) -> Result<bool, VerboseError> {
+        Ok(read_game(py, &self.0, |game| {
+            game.is_valid_plugin(&plugin_path)
+        })?)
     }
 
     #[expect(clippy::needless_pass_by_value, reason = "Required by PyO3")]
-    fn load_plugins(&mut self, plugin_paths: Vec<PathBuf>) -> Result<(), VerboseError> {
-        self.0.load_plugins(&as_paths(&plugin_paths))?;
+    fn load_plugins(&self, py: Python<'_>, plugin_paths: Vec<PathBuf>) -> Result<(), VerboseError> {
+        write_game(py, &self.0, |game| {
+            game.load_plugins(&as_paths(&plugin_paths))
+        })??;
         Ok(())
     }
 
     #[expect(clippy::needless_pass_by_value, reason = "Required by PyO3")]
-    fn load_plugin_headers(&mut self, plugin_paths: Vec<PathBuf>) -> Result<(), VerboseError> {
-        self.0.load_plugin_headers(&as_paths(&plugin_paths))?;
+    fn load_plugin_headers(
+        &self,
+        py: Python<'_>,
+        plugin_paths: Vec<PathBuf>,
+    ) -> Result<(), VerboseError> {
+        write_game(py, &self.0, |game| {
+            game.load_plugin_headers(&as_paths(&plugin_paths))
+        })??;
         Ok(())
     }
 
-    fn clear_loaded_plugins(&mut self) {
-        self.0.clear_loaded_plugins();
+    fn clear_loaded_plugins(&self, py: Python<'_>) -> Result<(), VerboseError> {
+        write_game(py, &self.0, libloot::Game::clear_loaded_plugins)?;
+        Ok(())
     }
 
-    fn plugin(&self, plugin_name: &str) -> Option<Plugin> {
-        self.0.plugin(plugin_name).map(Into::into)
+    fn plugin(&self, py: Python<'_>, plugin_name: &str) -> Result<Option<Plugin>, VerboseError> {
+        Ok(read_game(py, &self.0, |game| game.plugin(plugin_name))?.map(Into::into))
     }
 
-    fn loaded_plugins(&self) -> Vec<Plugin> {
-        self.0
-            .loaded_plugins()
+    fn loaded_plugins(&self, py: Python<'_>) -> Result<Vec<Plugin>, VerboseError> {
+        Ok(read_game(py, &self.0, libloot::Game::loaded_plugins)?
             .into_iter()
             .map(Into::into)
-            .collect()
+            .collect())
+    }
+
+    /// Get a summary of all loaded plugins packed into a single bytes object,
+    /// which avoids creating an object for each plugin. See the README for the
+    /// layout. If include_crcs is true, any CRCs that have not yet been
+    /// calculated are calculated in parallel.
+    #[pyo3(signature = (include_crcs = false))]
+    fn loaded_plugin_summaries<'py>(
+        &self,
+        py: Python<'py>,
+        include_crcs: bool,
+    ) -> Result<Bound<'py, PyBytes>, VerboseError> {
+        let buffer = read_game(py, &self.0, |game| {
+            game.loaded_plugin_summaries(include_crcs)
+        })??;
+
+        Ok(PyBytes::new(py, &buffer))
     }
 
     #[expect(clippy::needless_pass_by_value, reason = "Required by PyO3")]
-    fn sort_plugins(&self, plugin_names: Vec<String>) -> Result<Vec<String>, VerboseError> {
-        Ok(self.0.sort_plugins(&as_strs(&plugin_names))?)
+    fn sort_plugins(
+        &self,
+        py: Python<'_>,
+        plugin_names: Vec<String>,
+    ) -> Result<Vec<String>, VerboseError> {
+        let sorted = read_game(py, &self.0, |game| {
+            game.sort_plugins(&as_strs(&plugin_names))
+        })??;
+        Ok(sorted)
     }
 
-    fn load_current_load_order_state(&mut self) -> Result<(), VerboseError> {
-        self.0.load_current_load_order_state()?;
+    fn load_current_load_order_state(&self, py: Python<'_>) -> Result<(), VerboseError> {
+        write_game(py, &self.0, libloot::Game::load_current_load_order_state)??;
         Ok(())
     }
 
-    fn is_load_order_ambiguous(&self) -> Result<bool, VerboseError> {
-        Ok(self.0.is_load_order_ambiguous()?)
+    fn is_load_order_ambiguous(&self, py: Python<'_>) -> Result<bool, VerboseError> {
+        Ok(read_game(
+            py,
+            &self.0,
+            libloot::Game::is_load_order_ambiguous,
+        )??)
     }
 
-    fn active_plugins_file_path(&self) -> &PathBuf {
-        self.0.active_plugins_file_path()
+    fn active_plugins_file_path(&self, py: Python<'_>) -> Result<PathBuf, VerboseError> {
+        Ok(read_game(py, &self.0, |game| {
+            game.active_plugins_file_path().clone()
+        })?)
     }
 
-    fn is_plugin_active(&self, plugin_name: &str) -> bool {
-        self.0.is_plugin_active(plugin_name)
+    fn is_plugin_active(&self, py: Python<'_>, plugin_name: &str) -> Result<bool, VerboseError> {
+        Ok(read_game(py, &self.0, |game| {
+            game.is_plugin_active(plugin_name)
+        })?)
     }
 
-    fn load_order(&self) -> Vec<&str> {
-        self.0.load_order()
+    fn load_order(&self, py: Python<'_>) -> Result<Vec<String>, VerboseError> {
+        Ok(read_game(py, &self.0, |game| game.load_order().to_vec())?)
     }
 
     #[expect(clippy::needless_pass_by_value, reason = "Required by PyO3")]
-    fn set_load_order(&mut self, load_order: Vec<String>) -> Result<(), VerboseError> {
-        self.0.set_load_order(&as_strs(&load_order))?;
+    fn set_load_order(&self, py: Python<'_>, load_order: Vec<String>) -> Result<(), VerboseError> {
+        write_game(py, &self.0, |game| {
+            game.set_load_order(&as_strs(&load_order))
+        })??;
         Ok(())
     }
 }
 
+fn read_game<R: Ungil>(
+    py: Python<'_>,
+    game: &RwLock<libloot::Game>,
+    f: impl FnOnce(&libloot::Game) -> R + Ungil,
+) -> Result<R, GameLockPoisonError> {
+    lock::read(py, game, f)
+}
+
+fn write_game<R: Ungil>(
+    py: Python<'_>,
+    game: &RwLock<libloot::Game>,
+    f: impl FnOnce(&mut libloot::Game) -> R + Ungil,
+) -> Result<R, GameLockPoisonError> {
+    lock::write(py, game, f)
+}
+
 fn as_paths(pathbufs: &[PathBuf]) -> Vec<&Path> {
     pathbufs.iter().map(PathBuf::as_ref).collect()
 }
@@ -96,6 +96,7 @@
 mod database;
 mod error;
 mod game;
+mod lock;
 mod metadata;
 mod plugin;
 
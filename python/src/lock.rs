@@ -0,0 +1,39 @@
+use std::sync::{PoisonError, RwLock, RwLockReadGuard, RwLockWriteGuard};
+
+use pyo3::{Python, marker::Ungil};
+
+/// Call the given function with a shared lock on the given value, releasing
+/// the GIL before waiting for the lock and reacquiring it once the lock has
+/// been released.
+///
+/// libloot logs through Python's logging module, so a thread that holds a lock
+/// may need the GIL to make progress. Every lock must therefore be taken with
+/// the GIL released, as a thread that blocked on a lock while holding the GIL
+/// would deadlock with one that holds the lock and is waiting to log.
+pub(crate) fn read<T, R, E>(
+    py: Python<'_>,
+    lock: &RwLock<T>,
+    f: impl FnOnce(&T) -> R + Ungil,
+) -> Result<R, E>
+where
+    T: Send + Sync,
+    R: Ungil,
+    E: for<'a> From<PoisonError<RwLockReadGuard<'a, T>>> + Ungil,
+{
+    py.allow_threads(|| lock.read().map(|guard| f(&guard)).map_err(E::from))
+}
+
+/// Call the given function with an exclusive lock on the given value. The GIL
+/// is released in the same way as for [read].
+pub(crate) fn write<T, R, E>(
+    py: Python<'_>,
+    lock: &RwLock<T>,
+    f: impl FnOnce(&mut T) -> R + Ungil,
+) -> Result<R, E>
+where
+    T: Send + Sync,
+    R: Ungil,
+    E: for<'a> From<PoisonError<RwLockWriteGuard<'a, T>>> + Ungil,
+{
+    py.allow_threads(|| lock.write().map(|mut guard| f(&mut guard)).map_err(E::from))
+}
@@ -0,0 +1,84 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+"""Checks that concurrent calls can't deadlock on the GIL and libloot's locks.
+
+libloot logs through Python's logging module, so a thread that holds a game or
+database lock needs the GIL to log. Logging is enabled at libloot's trace level
+so that as many calls as possible need the GIL while holding a lock, and each
+test runs two threads that contend for the same lock.
+
+Build the wrapper first, e.g. using `maturin develop`, then run the tests from
+this directory's parent using `python -m unittest discover tests`.
+"""
+
+import logging
+import pathlib
+import tempfile
+import threading
+import unittest
+
+# pyo3-log maps trace-level messages to level 5.
+TRACE = 5
+
+logging.getLogger().addHandler(logging.NullHandler())
+logging.getLogger().setLevel(TRACE)
+
+import loot  # noqa: E402
+
+ITERATIONS = 200
+TIMEOUT_SECONDS = 60
+
+
+class LockingTest(unittest.TestCase):
+    def setUp(self):
+        temp_dir = tempfile.TemporaryDirectory()
+        self.addCleanup(temp_dir.cleanup)
+
+        game_path = pathlib.Path(temp_dir.name) / 'game'
+        local_path = pathlib.Path(temp_dir.name) / 'local'
+        (game_path / 'Data').mkdir(parents=True)
+        local_path.mkdir()
+
+        self.game = loot.Game(loot.GameType.Oblivion, game_path, local_path)
+
+    def run_concurrently(self, first, second):
+        errors = []
+
+        def repeat(function):
+            try:
+                for _ in range(ITERATIONS):
+                    function()
+            except Exception as error:
+                errors.append(error)
+
+        threads = [
+            threading.Thread(target=repeat, args=(function,), daemon=True)
+            for function in (first, second)
+        ]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join(TIMEOUT_SECONDS)
+
+        self.assertFalse(any(thread.is_alive() for thread in threads),
+                         'the threads deadlocked')
+        self.assertEqual([], errors)
+
+    def test_game_calls_should_not_deadlock(self):
+        self.run_concurrently(
+            self.game.load_current_load_order_state,
+            self.game.load_order,
+        )
+
+    def test_sorting_should_not_deadlock_with_database_calls(self):
+        database = self.game.database()
+
+        self.run_concurrently(
+            lambda: self.game.sort_plugins([]),
+            lambda: database.set_user_groups([]),
+        )
+
+
+if __name__ == '__main__':
+    unittest.main()
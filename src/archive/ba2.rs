@@ -1,6 +1,5 @@
 use std::{
     collections::{BTreeMap, BTreeSet},
-    hash::{DefaultHasher, Hash, Hasher},
     io::{BufRead, Seek},
 };
 
@@ -75,21 +74,25 @@ pub(super) fn read_assets<T: BufRead + Seek>(
 
     reader.seek(std::io::SeekFrom::Start(header.file_paths_offset))?;
 
+    // Paths are at most u16::MAX bytes long, so a single buffer can be reused
+    // for all of them instead of allocating one per path.
+    let mut file_path_buffer = Vec::new();
+
     for _ in 0..header.file_count {
         let mut length_buf = [0; 2];
         reader.read_exact(&mut length_buf)?;
 
         let path_length = u16::from_le_bytes(length_buf);
-        let mut file_path_bytes = vec![0; path_length.into()];
-        reader.read_exact(file_path_bytes.as_mut_slice())?;
+        file_path_buffer.resize(path_length.into(), 0);
+        reader.read_exact(file_path_buffer.as_mut_slice())?;
 
-        normalise_path(&mut file_path_bytes);
+        normalise_path(&mut file_path_buffer);
 
-        let file_path_bytes = trim_slashes(&file_path_bytes);
+        let file_path_bytes = trim_slashes(&file_path_buffer);
 
         let (folder_hash, file_hash) = rsplit_on(file_path_bytes, b'\\').map_or_else(
-            || (0, hash(&file_path_bytes)),
-            |(folder_path, file_path)| (hash(&folder_path), hash(&file_path)),
+            || (0, hash_path(file_path_bytes)),
+            |(folder_path, file_path)| (hash_path(folder_path), hash_path(file_path)),
         );
 
         let file_hashes: &mut BTreeSet<u64> = assets.entry(folder_hash).or_default();
@@ -106,16 +109,14 @@ pub(super) fn read_assets<T: BufRead + Seek>(
 }
 
 fn normalise_path(path_bytes: &mut [u8]) {
+    // This is written without any branches so that the compiler can vectorise
+    // it. Non-ASCII bytes are left unchanged because they're neither uppercase
+    // ASCII letters nor forward slashes.
     for byte in path_bytes {
-        // Ignore any non-ASCII characters.
-        if *byte > 127 {
-            continue;
-        }
+        let is_uppercase = byte.wrapping_sub(b'A') < 26;
+        let lowercased = *byte | (u8::from(is_uppercase) << 5u8);
 
-        *byte = match byte {
-            b'/' => b'\\',
-            _ => byte.to_ascii_lowercase(),
-        }
+        *byte = if *byte == b'/' { b'\\' } else { lowercased };
     }
 }
 
@@ -147,8 +148,91 @@ fn rsplit_on(slice: &[u8], needle: u8) -> Option<(&[u8], &[u8])> {
     Some((first, second))
 }
 
-fn hash<T: Hash>(value: &T) -> u64 {
-    let mut hasher = DefaultHasher::new();
-    value.hash(&mut hasher);
-    hasher.finish()
+/// A fast non-cryptographic 64-bit hash of the given bytes.
+///
+/// Unlike the standard library's DefaultHasher, the output of this function
+/// does not change between runs, Rust versions or platforms, so asset hashes
+/// are safe to persist. It reads the input in little-endian 8-byte words and
+/// uses MurmurHash3's 64-bit finaliser to mix the result.
+pub(super) fn hash_path(bytes: &[u8]) -> u64 {
+    const SEED: u64 = 0x9E37_79B9_7F4A_7C15;
+    const MULTIPLIER_1: u64 = 0x87C3_7B91_1142_53D5;
+    const MULTIPLIER_2: u64 = 0x4CF5_AD43_2745_937F;
+
+    let mix_word = |hash: u64, word: [u8; 8]| {
+        let word = u64::from_le_bytes(word)
+            .wrapping_mul(MULTIPLIER_1)
+            .rotate_left(31)
+            .wrapping_mul(MULTIPLIER_2);
+
+        (hash ^ word)
+            .rotate_left(27)
+            .wrapping_mul(5)
+            .wrapping_add(0x52DC_E729)
+    };
+
+    // Paths can't be longer than u16::MAX bytes, so this can't saturate in
+    // practice.
+    let length = u64::try_from(bytes.len()).unwrap_or(u64::MAX);
+    let mut hash = SEED ^ length.wrapping_mul(MULTIPLIER_1);
+
+    let chunks = bytes.chunks_exact(8);
+    let remainder = chunks.remainder();
+    for chunk in chunks {
+        if let Some(word) = chunk.first_chunk::<8>() {
+            hash = mix_word(hash, *word);
+        }
+    }
+
+    if !remainder.is_empty() {
+        let mut word = [0; 8];
+        if let Some(prefix) = word.get_mut(..remainder.len()) {
+            prefix.copy_from_slice(remainder);
+        }
+        hash = mix_word(hash, word);
+    }
+
+    finalise_hash(hash)
+}
+
+fn finalise_hash(mut hash: u64) -> u64 {
+    hash ^= hash >> 33;
+    hash = hash.wrapping_mul(0xFF51_AFD7_ED55_8CCD);
+    hash ^= hash >> 33;
+    hash = hash.wrapping_mul(0xC4CE_B9FE_1A85_EC53);
+    hash ^ (hash >> 33)
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    mod normalise_path {
+        use super::*;
+
+        #[test]
+        fn should_lowercase_ascii_and_replace_forward_slashes_only() {
+            let mut path = b"Textures/ARMOR\\Iron\xC1.DDS".to_vec();
+
+            normalise_path(&mut path);
+
+            assert_eq!(b"textures\\armor\\iron\xC1.dds".as_slice(), path.as_slice());
+        }
+    }
+
+    mod hash_path {
+        use super::*;
+
+        #[test]
+        fn should_be_stable() {
+            assert_eq!(0x9CA0_66F1_A4AB_2EEA, hash_path(b""));
+            assert_eq!(0x0503_782A_585B_F2EC, hash_path(b"a"));
+            assert_eq!(0x7B68_3987_5D94_B244, hash_path(b"blank.dds"));
+            assert_eq!(0x2D0A_89AA_B84D_728A, hash_path(b"license.txt"));
+            assert_eq!(
+                0x3EA5_F087_9C3A_5E9D,
+                hash_path(b"dev\\git\\testing-plugins")
+            );
+        }
+    }
 }
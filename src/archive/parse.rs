@@ -1,10 +1,13 @@
 use std::{
-    collections::{BTreeMap, BTreeSet},
+    cmp::Reverse,
+    collections::{BTreeMap, BTreeSet, BinaryHeap},
     fs::File,
     io::{BufReader, Read},
     path::{Path, PathBuf},
 };
 
+use rayon::iter::{IntoParallelRefIterator, ParallelIterator};
+
 use super::error::{ArchiveParsingError, ArchivePathParsingError};
 use crate::{
     archive::error::slice_too_small,
@@ -16,45 +19,100 @@ use crate::{
 use super::{ba2, bsa};
 
 pub fn assets_in_archives(archive_paths: &[PathBuf]) -> BTreeMap<u64, BTreeSet<u64>> {
-    let mut archive_assets: BTreeMap<u64, BTreeSet<u64>> = BTreeMap::new();
-
-    for archive_path in archive_paths {
-        logging::trace!(
-            "Getting assets loaded from the Bethesda archive at \"{}\"",
-            escape_ascii(archive_path)
-        );
-
-        let assets = match get_assets_in_archive(archive_path) {
-            Ok(a) => a,
-            Err(e) => {
-                logging::error!(
-                    "Encountered an error while trying to read the Bethesda archive at \"{}\": {}",
-                    escape_ascii(archive_path),
-                    format_details(&e)
-                );
-                continue;
+    // Archives are parsed in parallel, and each gives a sorted list of
+    // (folder hash, file hash) pairs, which are then merged in the same order
+    // as the archives are given so that hash collisions are detected and
+    // reported the same way as if the archives had been read one at a time.
+    let archive_assets: Vec<_> = archive_paths
+        .par_iter()
+        .map(|archive_path| {
+            logging::trace!(
+                "Getting assets loaded from the Bethesda archive at \"{}\"",
+                escape_ascii(archive_path)
+            );
+
+            match get_assets_in_archive(archive_path) {
+                Ok(a) => flatten_assets(a),
+                Err(e) => {
+                    logging::error!(
+                        "Encountered an error while trying to read the Bethesda archive at \"{}\": {}",
+                        escape_ascii(archive_path),
+                        format_details(&e)
+                    );
+                    Vec::new()
+                }
             }
-        };
+        })
+        .collect();
+
+    let merged_assets = merge_sorted_assets(archive_paths, archive_assets);
+
+    merged_assets
+        .chunk_by(|a, b| a.0 == b.0)
+        .filter_map(|chunk| {
+            chunk.first().map(|(folder_hash, _)| {
+                let file_hashes: BTreeSet<u64> =
+                    chunk.iter().map(|(_, file_hash)| *file_hash).collect();
+                (*folder_hash, file_hashes)
+            })
+        })
+        .collect()
+}
 
-        let warn_on_hash_collisions = should_warn_on_hash_collisions(archive_path);
+fn flatten_assets(assets: BTreeMap<u64, BTreeSet<u64>>) -> Vec<(u64, u64)> {
+    assets
+        .into_iter()
+        .flat_map(|(folder_hash, file_hashes)| {
+            file_hashes
+                .into_iter()
+                .map(move |file_hash| (folder_hash, file_hash))
+        })
+        .collect()
+}
 
-        for (folder_hash, file_hashes) in assets {
-            let entry_file_hashes = archive_assets.entry(folder_hash).or_default();
+/// Performs a k-way merge of the given sorted lists of assets, one per archive
+/// path, to give a single sorted and deduplicated list. An asset that has
+/// already been seen in an earlier archive is a hash collision.
+fn merge_sorted_assets(
+    archive_paths: &[PathBuf],
+    archive_assets: Vec<Vec<(u64, u64)>>,
+) -> Vec<(u64, u64)> {
+    let warnable_archive_paths: Vec<_> = archive_paths
+        .iter()
+        .map(|path| should_warn_on_hash_collisions(path).then_some(path))
+        .collect();
+
+    let capacity = archive_assets.iter().map(Vec::len).sum();
+    let mut iterators: Vec<_> = archive_assets.into_iter().map(Vec::into_iter).collect();
+
+    let mut heap = BinaryHeap::with_capacity(iterators.len());
+    for (archive_index, iter) in iterators.iter_mut().enumerate() {
+        if let Some(asset) = iter.next() {
+            heap.push(Reverse((asset, archive_index)));
+        }
+    }
 
-            for file_hash in file_hashes {
-                if !entry_file_hashes.insert(file_hash) && warn_on_hash_collisions {
-                    logging::warn!(
-                        "The folder and file with hashes {:x} and {:x} in \"{}\" are present in another Bethesda archive.",
-                        folder_hash,
-                        file_hash,
-                        escape_ascii(archive_path)
-                    );
-                }
+    let mut merged_assets = Vec::with_capacity(capacity);
+    while let Some(Reverse((asset, archive_index))) = heap.pop() {
+        if merged_assets.last() == Some(&asset) {
+            if let Some(Some(archive_path)) = warnable_archive_paths.get(archive_index) {
+                logging::warn!(
+                    "The folder and file with hashes {:x} and {:x} in \"{}\" are present in another Bethesda archive.",
+                    asset.0,
+                    asset.1,
+                    escape_ascii(archive_path)
+                );
             }
+        } else {
+            merged_assets.push(asset);
+        }
+
+        if let Some(next_asset) = iterators.get_mut(archive_index).and_then(Iterator::next) {
+            heap.push(Reverse((next_asset, archive_index)));
         }
     }
 
-    archive_assets
+    merged_assets
 }
 
 fn should_warn_on_hash_collisions(archive_path: &Path) -> bool {
@@ -133,22 +191,13 @@ mod tests {
     use super::*;
 
     mod get_assets_in_archive {
-        use std::{
-            hash::{DefaultHasher, Hash, Hasher},
-            io::SeekFrom,
-        };
+        use std::io::SeekFrom;
 
         use parameterized_test::{parameterized_test, test_parameter};
         use tempfile::tempdir;
 
         use super::*;
 
-        fn hash<T: Hash>(value: T) -> u64 {
-            let mut hasher = DefaultHasher::new();
-            value.hash(&mut hasher);
-            hasher.finish()
-        }
-
         #[test]
         fn should_error_if_file_cannot_be_opened() {
             let path = Path::new("./invalid.bsa");
@@ -216,8 +265,8 @@ mod tests {
 
             let files_count: usize = assets.values().map(BTreeSet::len).sum();
 
-            let expected_key = hash("dev\\git\\testing-plugins".as_bytes());
-            let expected_file_hash = hash("license.txt".as_bytes());
+            let expected_key = ba2::hash_path(b"dev\\git\\testing-plugins");
+            let expected_file_hash = ba2::hash_path(b"license.txt");
 
             assert_eq!(1, assets.len());
             assert_eq!(1, files_count);
@@ -235,8 +284,8 @@ mod tests {
 
             let files_count: usize = assets.values().map(BTreeSet::len).sum();
 
-            let expected_key = hash("dev\\git\\testing-plugins".as_bytes());
-            let expected_file_hash = hash("blank.dds".as_bytes());
+            let expected_key = ba2::hash_path(b"dev\\git\\testing-plugins");
+            let expected_file_hash = ba2::hash_path(b"blank.dds");
 
             assert_eq!(1, assets.len());
             assert_eq!(1, files_count);
@@ -270,6 +319,28 @@ mod tests {
         }
     }
 
+    mod merge_sorted_assets {
+        use super::*;
+
+        #[test]
+        fn should_merge_into_a_single_sorted_list_without_duplicates() {
+            let paths = [
+                PathBuf::from("a.bsa"),
+                PathBuf::from("b.bsa"),
+                PathBuf::from("c.bsa"),
+            ];
+            let assets = vec![
+                vec![(0, 1), (2, 3), (2, 4)],
+                vec![],
+                vec![(0, 0), (2, 3), (5, 0)],
+            ];
+
+            let merged = merge_sorted_assets(&paths, assets);
+
+            assert_eq!(vec![(0, 0), (0, 1), (2, 3), (2, 4), (5, 0)], merged);
+        }
+    }
+
     mod assets_in_archives {
         use super::*;
 
@@ -1,7 +1,7 @@
 mod conditions;
 mod error;
 
-use std::{collections::HashMap, path::Path};
+use std::{collections::HashMap, path::Path, sync::OnceLock};
 
 use conditions::{evaluate_all_conditions, evaluate_condition, filter_map_on_condition};
 
@@ -13,8 +13,8 @@ use crate::{
         metadata_document::MetadataDocument,
     },
     sorting::{
-        error::GroupsPathError,
-        groups::{build_groups_graph, find_path},
+        error::{BuildGroupsGraphError, GroupsPathError},
+        groups::{GroupsGraph, GroupsPathIndex, build_groups_graph},
         vertex::Vertex,
     },
 };
@@ -35,6 +35,10 @@ pub struct Database {
     masterlist: MetadataDocument,
     userlist: MetadataDocument,
     condition_evaluator_state: loot_condition_interpreter::State,
+    // This is built from the masterlist and userlist groups when first needed,
+    // and must be reset whenever either change. If the groups are invalid
+    // (e.g. cyclic), the error is cached instead.
+    groups_path_index: OnceLock<Result<GroupsPathIndex, BuildGroupsGraphError>>,
 }
 
 impl Database {
@@ -44,6 +48,7 @@ impl Database {
             masterlist: MetadataDocument::default(),
             userlist: MetadataDocument::default(),
             condition_evaluator_state,
+            groups_path_index: OnceLock::new(),
         }
     }
 
@@ -64,6 +69,7 @@ impl Database {
     ///
     /// Replaces any existing data that was previously loaded from a masterlist.
     pub fn load_masterlist(&mut self, path: &Path) -> Result<(), LoadMetadataError> {
+        self.reset_groups_path_index();
         self.masterlist.load(path)
     }
 
@@ -77,6 +83,7 @@ impl Database {
         masterlist_path: &Path,
         prelude_path: &Path,
     ) -> Result<(), LoadMetadataError> {
+        self.reset_groups_path_index();
         self.masterlist
             .load_with_prelude(masterlist_path, prelude_path)
     }
@@ -85,6 +92,7 @@ impl Database {
     ///
     /// Replaces any existing data that was previously loaded from a userlist.
     pub fn load_userlist(&mut self, path: &Path) -> Result<(), LoadMetadataError> {
+        self.reset_groups_path_index();
         self.userlist.load(path)
     }
 
@@ -204,6 +212,7 @@ impl Database {
     /// Sets the group definitions to store in the userlist, replacing any
     /// definitions already loaded from the userlist.
     pub fn set_user_groups(&mut self, groups: Vec<Group>) {
+        self.reset_groups_path_index();
         self.userlist.set_groups(groups);
     }
 
@@ -221,13 +230,33 @@ impl Database {
         from_group_name: &str,
         to_group_name: &str,
     ) -> Result<Vec<Vertex>, GroupsPathError> {
-        let graph = build_groups_graph(self.masterlist.groups(), self.userlist.groups())?;
+        let index = self.groups_path_index()?;
 
-        let path = find_path(&graph, from_group_name, to_group_name)?;
+        let path = index.find_path(from_group_name, to_group_name)?;
 
         Ok(path)
     }
 
+    /// Get the graph of the masterlist and userlist groups, which is built
+    /// when first needed and reused until the groups change.
+    pub(crate) fn groups_graph(&self) -> Result<&GroupsGraph, BuildGroupsGraphError> {
+        self.groups_path_index().map(GroupsPathIndex::graph)
+    }
+
+    fn groups_path_index(&self) -> Result<&GroupsPathIndex, BuildGroupsGraphError> {
+        self.groups_path_index
+            .get_or_init(|| {
+                build_groups_graph(self.masterlist.groups(), self.userlist.groups())
+                    .map(GroupsPathIndex::new)
+            })
+            .as_ref()
+            .map_err(Clone::clone)
+    }
+
+    fn reset_groups_path_index(&mut self) {
+        self.groups_path_index = OnceLock::new();
+    }
+
     /// Get all of a plugin's loaded metadata.
     ///
     /// If `include_user_metadata` is `true`, any user metadata the plugin has
@@ -303,6 +332,7 @@ impl Database {
     /// Discards all loaded user metadata for all groups, plugins, and any
     /// user-added general messages and known bash tags.
     pub fn discard_all_user_metadata(&mut self) {
+        self.reset_groups_path_index();
         self.userlist.clear();
     }
 }
@@ -966,6 +996,45 @@ plugins:
         );
     }
 
+    #[test]
+    fn groups_graph_should_be_rebuilt_when_groups_change() {
+        let fixture = Fixture::new(GameType::Oblivion);
+        let mut database = fixture.database();
+
+        database.load_masterlist(&fixture.metadata_path).unwrap();
+
+        let node_count = database.groups_graph().unwrap().node_count();
+
+        database.set_user_groups(vec![Group::new("group3".into())]);
+
+        assert_eq!(
+            node_count + 1,
+            database.groups_graph().unwrap().node_count()
+        );
+
+        database.discard_all_user_metadata();
+
+        assert_eq!(node_count, database.groups_graph().unwrap().node_count());
+    }
+
+    #[test]
+    fn groups_path_should_use_groups_set_after_a_previous_call() {
+        let fixture = Fixture::new(GameType::Oblivion);
+        let mut database = fixture.database();
+
+        database.load_masterlist(&fixture.metadata_path).unwrap();
+
+        assert!(database.groups_path("group1", "group3").is_err());
+
+        database.set_user_groups(vec![
+            Group::new("group3".into()).with_after_groups(vec!["group2".into()]),
+        ]);
+
+        let path = database.groups_path("group1", "group3").unwrap();
+
+        assert_eq!(3, path.len());
+    }
+
     mod plugin_metadata {
         use super::*;
 
@@ -71,6 +71,51 @@ impl From<loadorder::Error> for LoadOrderError {
     }
 }
 
+/// Represents an error that occurred while trying to create a thread pool.
+#[derive(Debug)]
+pub struct ThreadPoolCreationError(rayon::ThreadPoolBuildError);
+
+impl std::fmt::Display for ThreadPoolCreationError {
+    fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
+        write!(f, "failed to create a thread pool")
+    }
+}
+
+impl std::error::Error for ThreadPoolCreationError {
+    fn source(&self) -> Option<&(dyn std::error::Error + 'static)> {
+        Some(&self.0)
+    }
+}
+
+impl From<rayon::ThreadPoolBuildError> for ThreadPoolCreationError {
+    fn from(value: rayon::ThreadPoolBuildError) -> Self {
+        ThreadPoolCreationError(value)
+    }
+}
+
+/// Represents an error that occurred while writing cached sort results to a
+/// file.
+#[derive(Debug)]
+pub struct SortResultCacheWriteError(Box<std::io::Error>);
+
+impl std::fmt::Display for SortResultCacheWriteError {
+    fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
+        write!(f, "failed to write the sort result cache")
+    }
+}
+
+impl std::error::Error for SortResultCacheWriteError {
+    fn source(&self) -> Option<&(dyn std::error::Error + 'static)> {
+        Some(&self.0)
+    }
+}
+
+impl From<std::io::Error> for SortResultCacheWriteError {
+    fn from(value: std::io::Error) -> Self {
+        SortResultCacheWriteError(Box::new(value))
+    }
+}
+
 /// Indicates that the Database's RwLock wrapper has been poisoned and as such
 /// the Database may be in an invalid state.
 #[derive(Clone, Copy, Default, Debug, Eq, PartialEq, Ord, PartialOrd, Hash)]
@@ -165,6 +210,7 @@ impl From<PluginDataError> for LoadPluginsError {
 pub enum LoadOrderStateError {
     DatabaseLockPoisoned,
     LoadOrderError(LoadOrderError),
+    UnflushedChanges,
 }
 
 impl std::fmt::Display for LoadOrderStateError {
@@ -172,6 +218,7 @@ impl std::fmt::Display for LoadOrderStateError {
         match self {
             Self::DatabaseLockPoisoned => DatabaseLockPoisonError.fmt(f),
             Self::LoadOrderError(_) => write!(f, "failed to load the current load order state"),
+            Self::UnflushedChanges => write!(f, "the load order has unwritten changes"),
         }
     }
 }
@@ -179,7 +226,7 @@ impl std::fmt::Display for LoadOrderStateError {
 impl std::error::Error for LoadOrderStateError {
     fn source(&self) -> Option<&(dyn std::error::Error + 'static)> {
         match self {
-            Self::DatabaseLockPoisoned => None,
+            Self::DatabaseLockPoisoned | Self::UnflushedChanges => None,
             Self::LoadOrderError(e) => Some(e),
         }
     }
@@ -1,19 +1,23 @@
 use std::{
-    collections::{HashMap, HashSet},
+    collections::{HashMap, HashSet, hash_map::Entry},
     fmt::Display,
+    num::{NonZeroUsize, TryFromIntError},
     path::{Path, PathBuf},
-    sync::{Arc, RwLock},
+    sync::{Arc, Mutex, PoisonError, RwLock},
+    time::SystemTime,
 };
 
 use loadorder::WritableLoadOrder;
-use rayon::iter::{IntoParallelRefIterator, ParallelIterator};
+use rayon::iter::{IntoParallelRefIterator, IntoParallelRefMutIterator, ParallelIterator};
+use unicase::UniCase;
 
 use crate::{
     LogLevel,
+    archive::find_associated_archives,
     database::Database,
     error::{
         DatabaseLockPoisonError, GameHandleCreationError, LoadOrderError, LoadOrderStateError,
-        LoadPluginsError, SortPluginsError,
+        LoadPluginsError, SortPluginsError, SortResultCacheWriteError, ThreadPoolCreationError,
     },
     escape_ascii,
     logging::{self, format_details, is_log_enabled},
@@ -23,12 +27,17 @@ use crate::{
     },
     plugin::{
         LoadScope, Plugin,
-        error::{InvalidFilenameReason, PluginValidationError},
-        plugins_metadata, validate_plugin_path_and_header,
+        error::{InvalidFilenameReason, PluginDataError, PluginValidationError},
+        plugins_metadata,
+        summary::pack_plugin_summaries,
+        validate_plugin_path, validate_plugin_path_and_header,
     },
     sorting::{
-        groups::build_groups_graph,
-        plugins::{PluginSortingData, sort_plugins},
+        plugins::{
+            PluginSortingData, RecordOverlapCache, TieBreakStrategy, sort_inputs_fingerprint,
+            sort_plugins,
+        },
+        result_cache::SortResultCache,
     },
 };
 
@@ -145,6 +154,16 @@ pub struct Game {
     // loading plugins.
     database: Arc<RwLock<Database>>,
     cache: GameCache,
+    sort_result_cache: Option<SortResultCache>,
+    tie_break_strategy: TieBreakStrategy,
+    // The state of the load order's sources when it was last loaded, or None
+    // if it needs to be loaded again.
+    load_order_sources: Option<LoadOrderSources>,
+    load_order_snapshot: Arc<LoadOrderSnapshot>,
+    has_unsaved_load_order_changes: bool,
+    plugin_validity_cache: PluginValidityCache,
+    // Used for parallel work if set, otherwise rayon's global pool is used.
+    thread_pool: Option<rayon::ThreadPool>,
 }
 
 impl Game {
@@ -184,6 +203,13 @@ impl Game {
             load_order,
             database: Arc::new(RwLock::new(Database::new(condition_evaluator_state))),
             cache: GameCache::default(),
+            sort_result_cache: None,
+            tie_break_strategy: TieBreakStrategy::default(),
+            load_order_sources: None,
+            load_order_snapshot: Arc::default(),
+            has_unsaved_load_order_changes: false,
+            plugin_validity_cache: PluginValidityCache::default(),
+            thread_pool: None,
         })
     }
 
@@ -238,6 +264,13 @@ impl Game {
             load_order,
             database: Arc::new(RwLock::new(Database::new(condition_evaluator_state))),
             cache: GameCache::default(),
+            sort_result_cache: None,
+            tie_break_strategy: TieBreakStrategy::default(),
+            load_order_sources: None,
+            load_order_snapshot: Arc::default(),
+            has_unsaved_load_order_changes: false,
+            plugin_validity_cache: PluginValidityCache::default(),
+            thread_pool: None,
         })
     }
 
@@ -246,6 +279,37 @@ impl Game {
         self.base_type
     }
 
+    /// Set the number of threads that this game uses for parallel work, such
+    /// as loading plugins.
+    ///
+    /// If a thread count is given, this game gets its own thread pool with
+    /// that many threads. If no thread count is given, this game uses rayon's
+    /// global thread pool, which is the default.
+    pub fn set_thread_count(
+        &mut self,
+        thread_count: Option<NonZeroUsize>,
+    ) -> Result<(), ThreadPoolCreationError> {
+        self.thread_pool = thread_count
+            .map(|count| {
+                rayon::ThreadPoolBuilder::new()
+                    .num_threads(count.get())
+                    .thread_name(|i| format!("libloot-{i}"))
+                    .build()
+            })
+            .transpose()?;
+
+        Ok(())
+    }
+
+    /// Run the given function in this game's thread pool, so that any parallel
+    /// work that it does uses that pool.
+    fn install<R: Send>(&self, op: impl FnOnce() -> R + Send) -> R {
+        match &self.thread_pool {
+            Some(thread_pool) => thread_pool.install(op),
+            None => op(),
+        }
+    }
+
     /// Gets the currently-set additional data paths.
     ///
     /// The following games are configured with additional data paths by
@@ -282,6 +346,7 @@ impl Game {
         let mut database = self.database.write()?;
         database.clear_condition_cache();
 
+        self.load_order_sources = None;
         self.load_order
             .game_settings_mut()
             .set_additional_plugins_directories(paths.clone());
@@ -313,7 +378,31 @@ impl Game {
             &data_path(self.base_type, &self.install_path),
             plugin_path,
         );
-        validate_plugin_path_and_header(self.base_type, &resolved_path).is_ok()
+        self.plugin_validity_cache
+            .is_valid(self.base_type, &resolved_path)
+    }
+
+    /// Get the given files that are valid plugins, in the order they were
+    /// given.
+    ///
+    /// Each file is checked in the same way as [Game::is_valid_plugin], and
+    /// the files are checked in parallel. The results are cached using each
+    /// file's path, size and modification time, so checking an unchanged file
+    /// again only needs to read its metadata.
+    pub fn filter_valid_plugins<'a>(&self, plugin_paths: &[&'a Path]) -> Vec<&'a Path> {
+        let data_path = data_path(self.base_type, &self.install_path);
+
+        self.install(|| {
+            plugin_paths
+                .par_iter()
+                .filter(|path| {
+                    let resolved_path = resolve_plugin_path(self.base_type, &data_path, path);
+                    self.plugin_validity_cache
+                        .is_valid(self.base_type, &resolved_path)
+                })
+                .copied()
+                .collect()
+        })
     }
 
     /// Fully parses plugins and loads their data.
@@ -338,24 +427,13 @@ impl Game {
             self.base_type,
             GameType::Morrowind | GameType::OpenMW | GameType::Starfield
         ) {
-            let mut loaded_plugins: HashMap<Filename, &Plugin> = self
-                .cache
-                .plugins()
-                .iter()
-                .map(|(k, v)| (k.clone(), v.as_ref()))
-                .collect();
-
-            for plugin in &plugins {
-                loaded_plugins.insert(Filename::new(plugin.name().to_owned()), plugin);
-            }
-
-            let loaded_plugins: Vec<_> = loaded_plugins.into_values().collect();
+            let plugins_metadata = self.cache.plugins_metadata(&plugins)?;
 
-            let plugins_metadata = plugins_metadata(&loaded_plugins)?;
-
-            for plugin in &mut plugins {
-                plugin.resolve_record_ids(&plugins_metadata)?;
-            }
+            self.install(|| {
+                plugins
+                    .par_iter_mut()
+                    .try_for_each(|plugin| plugin.resolve_record_ids(&plugins_metadata))
+            })?;
         }
 
         self.store_plugins(plugins)?;
@@ -389,21 +467,51 @@ impl Game {
     ) -> Result<Vec<Plugin>, LoadPluginsError> {
         let data_path = data_path(self.base_type, &self.install_path);
 
-        validate_plugin_paths(self.base_type, &data_path, plugin_paths)?;
+        validate_plugin_filenames(plugin_paths)?;
 
         let archive_paths =
             find_archives(self.base_type, self.additional_data_paths(), &data_path)?;
 
-        self.cache.set_archive_paths(archive_paths);
+        // Plugins are validated as they're loaded, so that each file is only
+        // parsed once. Loading is done using a staged cache so that the game's
+        // state is only changed once all the given plugins have been validated.
+        let mut staged_cache = GameCache::default();
+        staged_cache.set_archive_paths(archive_paths);
+
+        let plugins = self.install(|| {
+            let resolved_paths: Vec<_> = plugin_paths
+                .par_iter()
+                .map(|path| {
+                    let resolved_path = resolve_plugin_path(self.base_type, &data_path, path);
+                    let archive_paths =
+                        find_associated_archives(self.base_type, &staged_cache, &resolved_path);
+                    let load_cost = plugin_load_cost(&resolved_path, &archive_paths, load_scope);
+                    (*path, resolved_path, archive_paths, load_cost)
+                })
+                .collect();
 
-        logging::trace!("Starting loading {load_scope}s.");
+            logging::trace!("Starting loading {load_scope}s.");
+
+            map_largest_first(
+                &resolved_paths,
+                |(_, _, _, load_cost)| *load_cost,
+                |(path, resolved_path, archive_paths, _)| {
+                    try_load_plugin(
+                        path,
+                        resolved_path,
+                        archive_paths,
+                        self.base_type,
+                        load_scope,
+                    )
+                },
+            )
+            .into_iter()
+            .collect::<Result<Vec<_>, _>>()
+        })?;
 
-        let plugins: Vec<_> = plugin_paths
-            .par_iter()
-            .filter_map(|path| {
-                try_load_plugin(&data_path, path, self.base_type, &self.cache, load_scope)
-            })
-            .collect();
+        let plugins: Vec<_> = plugins.into_iter().flatten().collect();
+
+        self.cache.archive_paths = staged_cache.archive_paths;
 
         Ok(plugins)
     }
@@ -436,6 +544,16 @@ impl Game {
         self.cache.plugins_iter().cloned().collect()
     }
 
+    /// Get a packed summary of all loaded plugins, as described in the
+    /// [plugin_summary](crate::plugin_summary) module. If `include_crcs` is
+    /// true, any CRCs that have not yet been calculated are calculated using
+    /// this game's thread pool.
+    pub fn loaded_plugin_summaries(&self, include_crcs: bool) -> Result<Vec<u8>, TryFromIntError> {
+        let plugins = self.loaded_plugins();
+
+        self.install(|| pack_plugin_summaries(&plugins, include_crcs))
+    }
+
     /// Calculates a new load order for the game's installed plugins (including
     /// inactive plugins) and returns the sorted order.
     ///
@@ -448,38 +566,227 @@ impl Game {
     /// their current load order. All given plugins must have been already been
     /// loaded using [Game::load_plugins] or [Game::load_plugin_headers].
     pub fn sort_plugins(&self, plugin_names: &[&str]) -> Result<Vec<String>, SortPluginsError> {
-        let plugins = plugin_names
+        let plugins = self.plugins_to_sort(plugin_names)?;
+
+        self.sort_loaded_plugins(&plugins, None)
+    }
+
+    /// Enables caching of sort results, so that if plugins are sorted again
+    /// with the same inputs, the previous result is returned without sorting.
+    ///
+    /// The inputs are the given plugins' data, the modification times and
+    /// sizes of their files, their order, the metadata that is used when
+    /// sorting them, the game's groups, its early-loading plugins and its tie
+    /// break strategy. Plugin files' contents are not checksummed, so if a file
+    /// is rewritten with the same size within the filesystem's timestamp
+    /// granularity, a stale cached result may be returned.
+    ///
+    /// If a path is given, cached results are read from that file if it
+    /// exists, and new results are written to it when
+    /// [Game::flush_sort_result_cache] is called, so that they can be reused
+    /// by other game handles. Any existing cached results are discarded,
+    /// including any that have not been flushed.
+    pub fn enable_sort_result_cache(&mut self, cache_path: Option<PathBuf>) {
+        self.sort_result_cache = Some(SortResultCache::new(cache_path));
+    }
+
+    /// Disables caching of sort results, discarding any cached results held in
+    /// memory, including any that have not been flushed.
+    pub fn disable_sort_result_cache(&mut self) {
+        self.sort_result_cache = None;
+    }
+
+    /// Writes cached sort results to the file given when the cache was
+    /// enabled, if there are any that haven't already been written.
+    ///
+    /// Does nothing if the cache is disabled or was enabled without a path.
+    pub fn flush_sort_result_cache(&self) -> Result<(), SortResultCacheWriteError> {
+        if let Some(cache) = &self.sort_result_cache {
+            cache.flush()?;
+        }
+
+        Ok(())
+    }
+
+    /// Set the strategy that sorting uses to decide the relative positions of
+    /// plugins that have no other reason to load in a particular order.
+    ///
+    /// [TieBreakStrategy::LoadOrderPaths] is used by default.
+    pub fn set_tie_break_strategy(&mut self, strategy: TieBreakStrategy) {
+        self.tie_break_strategy = strategy;
+    }
+
+    /// Sorts the given plugins like [Game::sort_plugins], but also returns a
+    /// session that holds intermediate results from the sort, so that the
+    /// plugins can be sorted again more quickly using
+    /// [Game::resort_plugins].
+    pub fn start_sort_session(
+        &self,
+        plugin_names: &[&str],
+    ) -> Result<SortSession, SortPluginsError> {
+        let mut session = SortSession {
+            plugin_names: plugin_names.iter().map(|n| (*n).to_owned()).collect(),
+            plugins: HashMap::new(),
+            record_overlaps: RecordOverlapCache::default(),
+            load_order: Vec::new(),
+        };
+
+        let plugin_names = session.plugin_names.clone();
+        self.sort_session_plugins(&mut session, &plugin_names)?;
+
+        Ok(session)
+    }
+
+    /// Applies the given changes to the plugins in a sort session, then sorts
+    /// them again and returns the new sorted order.
+    ///
+    /// The result is the same as calling [Game::sort_plugins] with the
+    /// session's current plugin names, but is calculated more quickly because
+    /// it reuses the results of checking which plugins have overlapping
+    /// records. Changes to plugin metadata don't need to be given, as metadata
+    /// is always re-evaluated, and any of the session's plugins that have been
+    /// reloaded since it was last sorted are detected automatically.
+    ///
+    /// If sorting fails, the changes are not applied to the session, so it
+    /// can still be used.
+    pub fn resort_plugins(
+        &self,
+        session: &mut SortSession,
+        changes: &[SortSessionChange],
+    ) -> Result<Vec<String>, SortPluginsError> {
+        let mut plugin_names = session.plugin_names.clone();
+        for change in changes {
+            SortSession::apply_change(&mut plugin_names, change);
+        }
+
+        self.sort_session_plugins(session, &plugin_names)?;
+
+        session.plugin_names = plugin_names;
+
+        Ok(session.load_order.clone())
+    }
+
+    /// Sort the given plugins, reusing and updating the session's plugins and
+    /// overlap results. The session's load order is only changed if sorting
+    /// succeeds, and its plugin names are left unchanged.
+    fn sort_session_plugins(
+        &self,
+        session: &mut SortSession,
+        plugin_names: &[String],
+    ) -> Result<(), SortPluginsError> {
+        let plugin_names: Vec<_> = plugin_names.iter().map(String::as_str).collect();
+        let plugins = self.plugins_to_sort(&plugin_names)?;
+
+        // Discard overlap results for any plugins that have been reloaded.
+        let record_overlaps = &mut session.record_overlaps;
+        session.plugins.retain(|name, plugin| {
+            let is_current = self
+                .cache
+                .plugin(name.as_str())
+                .is_some_and(|p| Arc::ptr_eq(p, plugin));
+            if !is_current {
+                record_overlaps.remove_plugin(name.as_str());
+            }
+            is_current
+        });
+
+        for plugin in &plugins {
+            session
+                .plugins
+                .entry(Filename::new(plugin.name().to_owned()))
+                .or_insert_with(|| Arc::clone(plugin));
+        }
+
+        session.load_order =
+            self.sort_loaded_plugins(&plugins, Some(&mut session.record_overlaps))?;
+
+        // Now that sorting has succeeded, forget plugins that are no longer
+        // part of the session.
+        let plugin_names: HashSet<_> = plugin_names
+            .iter()
+            .map(|n| Filename::new((*n).to_owned()))
+            .collect();
+        let record_overlaps = &mut session.record_overlaps;
+        session.plugins.retain(|name, _| {
+            let is_sorted = plugin_names.contains(name);
+            if !is_sorted {
+                record_overlaps.remove_plugin(name.as_str());
+            }
+            is_sorted
+        });
+
+        Ok(())
+    }
+
+    fn plugins_to_sort(
+        &self,
+        plugin_names: &[&str],
+    ) -> Result<Vec<&Arc<Plugin>>, SortPluginsError> {
+        plugin_names
             .iter()
             .map(|n| {
                 self.cache
                     .plugin(n)
                     .ok_or_else(|| SortPluginsError::PluginNotLoaded((*n).to_owned()))
             })
-            .collect::<Result<Vec<_>, _>>()?;
+            .collect()
+    }
 
+    fn sort_loaded_plugins(
+        &self,
+        plugins: &[&Arc<Plugin>],
+        record_overlaps: Option<&mut RecordOverlapCache>,
+    ) -> Result<Vec<String>, SortPluginsError> {
         let database = self.database.read()?;
 
         let plugins_sorting_data = plugins
-            .into_iter()
+            .iter()
             .enumerate()
             .map(|(i, p)| to_plugin_sorting_data(&database, p, i))
             .collect::<Result<Vec<_>, _>>()?;
 
         if is_log_enabled(LogLevel::Debug) {
             logging::debug!("Current load order:");
-            for plugin_name in plugin_names {
-                logging::debug!("\t{plugin_name}");
+            for plugin in plugins {
+                logging::debug!("\t{}", plugin.name());
             }
         }
 
-        let groups_graph = build_groups_graph(&database.groups(false), database.user_groups())?;
+        let groups_graph = database.groups_graph()?;
+        let early_loading_plugins = self.load_order.game_settings().early_loading_plugins();
+
+        let fingerprint = match &self.sort_result_cache {
+            Some(cache) => {
+                let fingerprint = sort_inputs_fingerprint(
+                    &plugins_sorting_data,
+                    groups_graph,
+                    early_loading_plugins,
+                    self.tie_break_strategy,
+                )?;
+
+                let plugin_names: Vec<_> = plugins.iter().map(|p| p.name()).collect();
+                if let Some(load_order) = cache.get(fingerprint, &plugin_names) {
+                    logging::debug!("Using a cached sort result for the given plugins");
+                    return Ok(load_order);
+                }
+
+                Some(fingerprint)
+            }
+            None => None,
+        };
 
         let new_load_order = sort_plugins(
             plugins_sorting_data,
-            &groups_graph,
-            self.load_order.game_settings().early_loading_plugins(),
+            groups_graph,
+            early_loading_plugins,
+            record_overlaps,
+            self.tie_break_strategy,
         )?;
 
+        if let (Some(cache), Some(fingerprint)) = (&self.sort_result_cache, fingerprint) {
+            cache.insert(fingerprint, &new_load_order);
+        }
+
         if is_log_enabled(LogLevel::Debug) {
             logging::debug!("Sorted load order:");
             for plugin_name in &new_load_order {
@@ -492,20 +799,56 @@ impl Game {
 
     /// Load the current load order state, discarding any previously held state.
     ///
+    /// Fails without changing any state if there are moves made by
+    /// [Game::move_plugins] that have not been written by
+    /// [Game::flush_load_order], as they would otherwise be lost.
+    ///
     /// This function should be called whenever the load order or active state
     /// of plugins "on disk" changes, so that the cached state is updated to
     /// reflect the changes.
     ///
-    /// Loading the current load order state clears the condition cache in this
-    /// game's database object.
+    /// The modification times and sizes of the load order's source files and
+    /// of the entries in the game's plugin directories are recorded when the
+    /// state is loaded, and if none of them have changed since then, the load
+    /// order is not read again.
+    ///
+    /// The condition cache in this game's database object is always cleared,
+    /// as conditions can depend on files that aren't recorded, such as those
+    /// in subdirectories of the plugin directories.
     pub fn load_current_load_order_state(&mut self) -> Result<(), LoadOrderStateError> {
-        self.load_order.load()?;
+        if self.has_unsaved_load_order_changes {
+            return Err(LoadOrderStateError::UnflushedChanges);
+        }
+
+        let sources = LoadOrderSources::read(self.load_order.game_settings());
+
+        let previous_sources = self.load_order_sources.take();
+        if previous_sources.as_ref() == Some(&sources) {
+            logging::debug!("The load order's sources are unchanged, skipping reload");
+            self.load_order_sources = previous_sources;
+            self.database.write()?.clear_condition_cache();
+            return Ok(());
+        }
+
+        let load_result = self.load_order.load();
+
+        let previous_snapshot = self.refresh_load_order_snapshot();
+        load_result?;
+
+        let active_plugins_changed =
+            previous_snapshot.active_plugins != self.load_order_snapshot.active_plugins;
+
+        self.load_order_sources = Some(sources);
 
         let mut database = self.database.write()?;
         database.clear_condition_cache();
-        database
-            .condition_evaluator_state_mut()
-            .set_active_plugins(&self.load_order.active_plugin_names());
+
+        if active_plugins_changed {
+            database
+                .condition_evaluator_state_mut()
+                .set_active_plugins(&self.load_order.active_plugin_names());
+        }
+
         Ok(())
     }
 
@@ -529,12 +872,20 @@ impl Game {
 
     /// Check if the given plugin is active.
     pub fn is_plugin_active(&self, plugin_name: &str) -> bool {
-        self.load_order.is_active(plugin_name)
+        self.load_order_snapshot.is_active(plugin_name)
     }
 
     /// Get the current load order.
-    pub fn load_order(&self) -> Vec<&str> {
-        self.load_order.plugin_names()
+    pub fn load_order(&self) -> &[String] {
+        self.load_order_snapshot.plugin_names()
+    }
+
+    /// Get a snapshot of the current load order. The snapshot is shared
+    /// until the load order is next changed by
+    /// [Game::load_current_load_order_state] or [Game::set_load_order], so
+    /// getting it does not copy the load order.
+    pub fn load_order_snapshot(&self) -> Arc<LoadOrderSnapshot> {
+        Arc::clone(&self.load_order_snapshot)
     }
 
     /// Set the game's load order.
@@ -543,10 +894,88 @@ impl Game {
     /// setting an OpenMW load order will have no effect if the relative order
     /// of active plugins is unchanged.
     pub fn set_load_order(&mut self, load_order: &[&str]) -> Result<(), LoadOrderError> {
-        self.load_order.set_load_order(load_order)?;
+        self.load_order_sources = None;
+        let result = self.load_order.set_load_order(load_order);
+        self.refresh_load_order_snapshot();
+        result?;
+
         self.load_order.save()?;
+        self.has_unsaved_load_order_changes = false;
+        Ok(())
+    }
+
+    /// Move plugins to new positions in the game's load order.
+    ///
+    /// Each move is a plugin filename and the position to move it to, and the
+    /// moves are applied in the given order. Only the moved plugins are
+    /// validated, and if any of the moves are invalid, none of them are
+    /// applied.
+    ///
+    /// The new load order is only written when [Game::flush_load_order] is
+    /// called, so that many moves can be written together. **Call
+    /// [Game::flush_load_order] before calling
+    /// [Game::load_current_load_order_state]**, which fails while there are
+    /// moves that have not been written. Moves that have not been written are
+    /// discarded if the game is dropped first.
+    pub fn move_plugins(&mut self, moves: &[(&str, usize)]) -> Result<(), LoadOrderError> {
+        let result = moves.iter().try_for_each(|(name, position)| {
+            self.load_order
+                .set_plugin_index(name, *position)
+                .map(|_| ())
+        });
+
+        if let Err(e) = result {
+            let previous_snapshot = Arc::clone(&self.load_order_snapshot);
+            let previous_load_order: Vec<_> = previous_snapshot
+                .plugin_names()
+                .iter()
+                .map(String::as_str)
+                .collect();
+
+            if let Err(restore_error) = self.load_order.set_load_order(&previous_load_order) {
+                logging::error!(
+                    "Failed to restore the load order after an invalid move: {}",
+                    format_details(&restore_error)
+                );
+                self.refresh_load_order_snapshot();
+
+                // The load order may still differ from the one that was last
+                // written, so make sure it isn't silently replaced.
+                self.load_order_sources = None;
+                self.has_unsaved_load_order_changes = true;
+            }
+
+            return Err(e.into());
+        }
+
+        self.refresh_load_order_snapshot();
+        if !moves.is_empty() {
+            self.load_order_sources = None;
+            self.has_unsaved_load_order_changes = true;
+        }
+
+        Ok(())
+    }
+
+    /// Write any load order changes made by [Game::move_plugins] that have not
+    /// yet been written. Does nothing if there are no unwritten changes.
+    pub fn flush_load_order(&mut self) -> Result<(), LoadOrderError> {
+        if self.has_unsaved_load_order_changes {
+            self.load_order.save()?;
+            self.has_unsaved_load_order_changes = false;
+        }
+
         Ok(())
     }
+
+    /// Replace the load order snapshot with one of the current load order,
+    /// returning the previous snapshot.
+    fn refresh_load_order_snapshot(&mut self) -> Arc<LoadOrderSnapshot> {
+        std::mem::replace(
+            &mut self.load_order_snapshot,
+            Arc::new(LoadOrderSnapshot::new(self.load_order.as_ref())),
+        )
+    }
 }
 
 fn resolve_path(path: &Path) -> PathBuf {
@@ -587,11 +1016,7 @@ fn new_condition_evaluator_state(
     condition_evaluator_state
 }
 
-fn validate_plugin_paths(
-    game_type: GameType,
-    data_path: &Path,
-    plugin_paths: &[&Path],
-) -> Result<(), PluginValidationError> {
+fn validate_plugin_filenames(plugin_paths: &[&Path]) -> Result<(), PluginValidationError> {
     // Check that all plugin filenames are unique.
     let mut set = HashSet::new();
     for path in plugin_paths {
@@ -612,13 +1037,7 @@ fn validate_plugin_paths(
         }
     }
 
-    plugin_paths
-        .par_iter()
-        .map(|path| {
-            let resolved_path = resolve_plugin_path(game_type, data_path, path);
-            validate_plugin_path_and_header(game_type, &resolved_path)
-        })
-        .collect()
+    Ok(())
 }
 
 fn find_archives(
@@ -668,27 +1087,84 @@ fn find_archives_in_path(
 }
 
 fn try_load_plugin(
-    data_path: &Path,
     plugin_path: &Path,
+    resolved_path: &Path,
+    archive_paths: &[PathBuf],
     game_type: GameType,
-    game_cache: &GameCache,
     load_scope: LoadScope,
-) -> Option<Plugin> {
-    let resolved_path = resolve_plugin_path(game_type, data_path, plugin_path);
+) -> Result<Option<Plugin>, PluginValidationError> {
+    validate_plugin_path(game_type, resolved_path)?;
 
-    match Plugin::new(game_type, game_cache, &resolved_path, load_scope) {
-        Ok(p) => Some(p),
+    match Plugin::with_archive_paths(game_type, resolved_path, archive_paths.to_vec(), load_scope) {
+        Ok(p) => Ok(Some(p)),
         Err(e) => {
+            // Distinguish between an invalid plugin, which fails the whole
+            // load, and a valid plugin that couldn't be loaded, which is
+            // skipped. This only reads the file again if loading it failed.
+            validate_plugin_path_and_header(game_type, resolved_path)?;
+
             logging::error!(
                 "Caught error while trying to load \"{}\": {}",
                 escape_ascii(plugin_path),
                 format_details(&e)
             );
-            None
+            Ok(None)
         }
     }
 }
 
+/// Estimate the cost of loading a plugin from the size of its file and, when
+/// loading whole plugins, the sizes of the archives that it loads.
+fn plugin_load_cost(plugin_path: &Path, archive_paths: &[PathBuf], load_scope: LoadScope) -> u64 {
+    let file_size = |path: &Path| path.metadata().map(|m| m.len()).unwrap_or(0);
+
+    let mut cost = file_size(plugin_path);
+
+    if load_scope == LoadScope::WholePlugin {
+        cost += archive_paths.iter().map(|p| file_size(p)).sum::<u64>();
+    }
+
+    cost
+}
+
+/// Map the given items in parallel, starting with the items that have the
+/// largest costs, and return the results in the order of the given items.
+///
+/// Rayon splits a slice into contiguous ranges, so an expensive item near the
+/// end of a slice can start late and finish long after every other item. Each
+/// item is instead spawned as its own FIFO task in order of decreasing cost, so
+/// idle workers always take the most expensive item that hasn't started, and
+/// workers that are waiting on nested parallel work can steal tasks too.
+fn map_largest_first<T: Sync, R: Send>(
+    items: &[T],
+    cost: impl Fn(&T) -> u64,
+    map: impl Fn(&T) -> R + Sync,
+) -> Vec<R> {
+    let mut schedule: Vec<_> = items.iter().enumerate().collect();
+    schedule.sort_by_key(|(_, item)| std::cmp::Reverse(cost(*item)));
+
+    let results = Mutex::new(Vec::with_capacity(items.len()));
+
+    rayon::scope_fifo(|scope| {
+        for (index, item) in schedule {
+            let map = &map;
+            let results = &results;
+            scope.spawn_fifo(move |_| {
+                let result = map(item);
+                results
+                    .lock()
+                    .unwrap_or_else(PoisonError::into_inner)
+                    .push((index, result));
+            });
+        }
+    });
+
+    let mut results = results.into_inner().unwrap_or_else(PoisonError::into_inner);
+    results.sort_unstable_by_key(|(index, _)| *index);
+
+    results.into_iter().map(|(_, result)| result).collect()
+}
+
 fn resolve_plugin_path(game_type: GameType, data_path: &Path, plugin_path: &Path) -> PathBuf {
     let plugin_path = data_path.join(plugin_path);
 
@@ -722,7 +1198,10 @@ fn update_loaded_plugin_state<'a>(
             plugin_versions.push((plugin.name(), version));
         }
 
-        if let Some(crc) = plugin.crc() {
+        // Plugins' CRCs are calculated lazily, so only pass on those that
+        // are already known: the condition interpreter will calculate any
+        // others that conditions need.
+        if let Some(crc) = plugin.cached_crc() {
             plugin_crcs.push((plugin.name(), crc));
         }
     }
@@ -747,6 +1226,141 @@ fn update_loaded_plugin_state<'a>(
     }
 }
 
+/// An immutable snapshot of a game's load order and which plugins in it are
+/// active.
+#[derive(Debug, Default)]
+pub struct LoadOrderSnapshot {
+    plugin_names: Box<[String]>,
+    /// Sorted so that plugins can be looked up by a borrowed name without
+    /// allocating a case-folded key.
+    active_plugins: Box<[Filename]>,
+}
+
+impl LoadOrderSnapshot {
+    fn new(load_order: &(dyn WritableLoadOrder + Send + Sync + 'static)) -> Self {
+        let mut active_plugins: Vec<_> = load_order
+            .active_plugin_names()
+            .into_iter()
+            .map(|n| Filename::new(n.to_owned()))
+            .collect();
+        active_plugins.sort_unstable();
+
+        Self {
+            plugin_names: load_order
+                .plugin_names()
+                .into_iter()
+                .map(str::to_owned)
+                .collect(),
+            active_plugins: active_plugins.into_boxed_slice(),
+        }
+    }
+
+    /// Get the plugin filenames in their load order.
+    pub fn plugin_names(&self) -> &[String] {
+        &self.plugin_names
+    }
+
+    /// Check if the given plugin is active. The check is case-insensitive.
+    pub fn is_active(&self, plugin_name: &str) -> bool {
+        let plugin_name = UniCase::new(plugin_name);
+        self.active_plugins
+            .binary_search_by(|n| UniCase::new(n.as_str()).cmp(&plugin_name))
+            .is_ok()
+    }
+}
+
+/// The modification times and sizes of the files and directory entries that
+/// a load order is read from, used to detect when it needs to be read again.
+#[derive(Debug, PartialEq, Eq)]
+struct LoadOrderSources {
+    files: Vec<Option<FileStamp>>,
+    plugin_directory_entries: Vec<(PathBuf, Option<FileStamp>)>,
+}
+
+pub(crate) type FileStamp = (SystemTime, u64);
+
+impl LoadOrderSources {
+    fn read(settings: &loadorder::GameSettings) -> Self {
+        let files = std::iter::once(settings.active_plugins_file())
+            .chain(settings.load_order_file())
+            .map(|p| file_stamp(p))
+            .collect();
+
+        let mut plugin_directory_entries = Vec::new();
+        for directory in std::iter::once(&settings.plugins_directory())
+            .chain(settings.additional_plugins_directories())
+        {
+            plugin_directory_entries.push((directory.clone(), file_stamp(directory)));
+
+            // Listing a directory doesn't require opening its entries, and
+            // plugin timestamps can affect the load order, so the entries are
+            // checked individually instead of relying on the directory's
+            // timestamp.
+            if let Ok(entries) = directory.read_dir() {
+                let start = plugin_directory_entries.len();
+
+                plugin_directory_entries.extend(entries.filter_map(Result::ok).map(|e| {
+                    let stamp = e.metadata().ok().and_then(|m| metadata_stamp(&m));
+                    (e.path(), stamp)
+                }));
+
+                if let Some(entries) = plugin_directory_entries.get_mut(start..) {
+                    entries.sort_unstable_by(|a, b| a.0.cmp(&b.0));
+                }
+            }
+        }
+
+        Self {
+            files,
+            plugin_directory_entries,
+        }
+    }
+}
+
+/// Caches whether files are valid plugins, keyed by their paths and checked
+/// against their sizes and modification times.
+#[derive(Debug, Default)]
+struct PluginValidityCache(Mutex<HashMap<PathBuf, (FileStamp, bool)>>);
+
+impl PluginValidityCache {
+    fn is_valid(&self, game_type: GameType, plugin_path: &Path) -> bool {
+        let Some(stamp) = file_stamp(plugin_path) else {
+            return validate_plugin_path_and_header(game_type, plugin_path).is_ok();
+        };
+
+        let cached = match self.0.lock() {
+            Ok(entries) => entries
+                .get(plugin_path)
+                .filter(|(cached_stamp, _)| *cached_stamp == stamp)
+                .map(|(_, is_valid)| *is_valid),
+            Err(_) => {
+                logging::error!("The plugin validity cache's lock is poisoned");
+                return validate_plugin_path_and_header(game_type, plugin_path).is_ok();
+            }
+        };
+
+        if let Some(is_valid) = cached {
+            return is_valid;
+        }
+
+        let is_valid = validate_plugin_path_and_header(game_type, plugin_path).is_ok();
+
+        if let Ok(mut entries) = self.0.lock() {
+            entries.insert(plugin_path.to_path_buf(), (stamp, is_valid));
+        }
+
+        is_valid
+    }
+}
+
+pub(crate) fn file_stamp(path: &Path) -> Option<FileStamp> {
+    path.metadata().ok().and_then(|m| metadata_stamp(&m))
+}
+
+fn metadata_stamp(metadata: &std::fs::Metadata) -> Option<FileStamp> {
+    metadata.modified().ok().map(|t| (t, metadata.len()))
+}
+
 fn to_plugin_sorting_data<'a>(
     database: &Database,
     plugin: &'a Arc<Plugin>,
@@ -771,12 +1385,67 @@ fn to_plugin_sorting_data<'a>(
     .map_err(Into::into)
 }
 
-#[derive(Clone, Debug, Default, Eq, PartialEq)]
+/// Holds the state of a sort so that the same plugins can be sorted again more
+/// quickly after a small change. Sessions are created using
+/// [Game::start_sort_session] and used with [Game::resort_plugins].
+#[derive(Debug)]
+pub struct SortSession {
+    plugin_names: Vec<String>,
+    plugins: HashMap<Filename, Arc<Plugin>>,
+    record_overlaps: RecordOverlapCache,
+    load_order: Vec<String>,
+}
+
+impl SortSession {
+    /// Get the filenames of the plugins that are sorted, in their current load
+    /// order.
+    pub fn plugin_names(&self) -> &[String] {
+        &self.plugin_names
+    }
+
+    /// Get the load order that was calculated by the session's last sort.
+    pub fn sorted_load_order(&self) -> &[String] {
+        &self.load_order
+    }
+
+    fn apply_change(plugin_names: &mut Vec<String>, change: &SortSessionChange) {
+        match change {
+            SortSessionChange::PluginAdded(name) => {
+                if !plugin_names.iter().any(|n| unicase::eq(n, name)) {
+                    plugin_names.push(name.clone());
+                }
+            }
+            SortSessionChange::PluginRemoved(name) => {
+                plugin_names.retain(|n| !unicase::eq(n, name));
+            }
+        }
+    }
+}
+
+/// A change to the plugins that are sorted in a [SortSession].
+#[derive(Clone, Debug, PartialEq, Eq, Hash)]
+pub enum SortSessionChange {
+    /// The plugin with the given filename is added to the end of the current
+    /// load order. It must have already been loaded.
+    PluginAdded(String),
+    /// The plugin with the given filename is removed from the current load
+    /// order.
+    PluginRemoved(String),
+}
+
+#[derive(Clone, Debug, Default)]
 pub(crate) struct GameCache {
     plugins: HashMap<Filename, Arc<Plugin>>,
     archive_paths: HashSet<PathBuf>,
+    plugins_metadata: PluginsMetadataCache,
 }
 
+/// The esplugin metadata of loaded plugins, which is needed to resolve the
+/// record IDs of plugins that are loaded after them. It's derived from the
+/// loaded plugins.
+#[derive(Clone, Debug, Default)]
+struct PluginsMetadataCache(HashMap<Filename, Box<[esplugin::PluginMetadata]>>);
+
 impl GameCache {
     pub fn set_archive_paths(&mut self, archive_paths: Vec<PathBuf>) {
         self.archive_paths.clear();
@@ -785,17 +1454,52 @@ impl GameCache {
 
     fn insert_plugins(&mut self, plugins: Vec<Plugin>) {
         for plugin in plugins {
-            self.plugins
-                .insert(Filename::new(plugin.name().to_owned()), Arc::new(plugin));
+            let name = Filename::new(plugin.name().to_owned());
+            self.plugins_metadata.0.remove(&name);
+            self.plugins.insert(name, Arc::new(plugin));
         }
     }
 
     fn clear_plugins(&mut self) {
         self.plugins.clear();
+        self.plugins_metadata.0.clear();
     }
 
-    fn plugins(&self) -> &HashMap<Filename, Arc<Plugin>> {
-        &self.plugins
+    /// Get the metadata needed to resolve the record IDs of the given plugins,
+    /// which replace any loaded plugins with the same names.
+    ///
+    /// The metadata of loaded plugins is cached the first time it's needed,
+    /// after their record IDs have been resolved, so that it's the same as if
+    /// it was calculated from the loaded plugins each time.
+    fn plugins_metadata(
+        &mut self,
+        new_plugins: &[Plugin],
+    ) -> Result<Vec<esplugin::PluginMetadata>, PluginDataError> {
+        let new_plugin_names: HashSet<_> = new_plugins
+            .iter()
+            .map(|p| Filename::new(p.name().to_owned()))
+            .collect();
+
+        let mut metadata = plugins_metadata(&new_plugins.iter().collect::<Vec<_>>())?;
+
+        let cache = &mut self.plugins_metadata.0;
+        self.plugins
+            .iter()
+            .filter(|(name, _)| !new_plugin_names.contains(*name))
+            .try_for_each(|(name, plugin)| {
+                let plugin_metadata = match cache.entry(name.clone()) {
+                    Entry::Occupied(entry) => entry.into_mut(),
+                    Entry::Vacant(entry) => {
+                        entry.insert(plugins_metadata(&[plugin.as_ref()])?.into_boxed_slice())
+                    }
+                };
+
+                metadata.extend(plugin_metadata.iter().cloned());
+
+                Ok::<_, PluginDataError>(())
+            })?;
+
+        Ok(metadata)
     }
 
     fn plugins_iter(&self) -> impl Iterator<Item = &Arc<Plugin>> {
@@ -1421,14 +2125,12 @@ mod tests {
             }
         }
 
-        mod load_plugin_headers {
-            use crate::tests::NON_PLUGIN_FILE;
-
+        mod set_thread_count {
             use super::*;
 
-            #[parameterized_test(ALL_GAME_TYPES)]
-            fn should_load_the_headers_of_the_given_plugins(game_type: GameType) {
-                let fixture = Fixture::new(game_type);
+            #[test]
+            fn should_run_parallel_work_using_the_given_number_of_threads() {
+                let fixture = Fixture::new(GameType::Oblivion);
 
                 let mut game = Game::with_local_path(
                     fixture.game_type,
@@ -1437,24 +2139,19 @@ mod tests {
                 )
                 .unwrap();
 
-                assert!(game.plugin(BLANK_ESM).is_none());
-                assert!(game.plugin(BLANK_DIFFERENT_ESM).is_none());
-                assert!(game.plugin(BLANK_ESP).is_none());
+                game.set_thread_count(NonZeroUsize::new(3)).unwrap();
 
-                game.load_plugin_headers(&[Path::new(BLANK_ESM), Path::new(BLANK_ESP)])
-                    .unwrap();
+                assert_eq!(3, game.install(rayon::current_num_threads));
 
-                let plugin = game.plugin(BLANK_ESM).unwrap();
-                assert_eq!("5.0", plugin.version().unwrap());
-                assert!(plugin.crc().is_none());
+                game.load_plugins(&[Path::new(BLANK_ESM), Path::new(BLANK_ESP)])
+                    .unwrap();
 
-                assert!(game.plugin(BLANK_DIFFERENT_ESM).is_none());
-                assert!(game.plugin(BLANK_ESP).is_some());
+                assert_eq!(2, game.loaded_plugins().len());
             }
 
             #[test]
-            fn should_not_modify_loaded_plugins_storage_if_given_a_non_plugin() {
-                let fixture = Fixture::new(GameType::Morrowind);
+            fn should_use_the_global_thread_pool_if_no_thread_count_is_given() {
+                let fixture = Fixture::new(GameType::Oblivion);
 
                 let mut game = Game::with_local_path(
                     fixture.game_type,
@@ -1463,16 +2160,119 @@ mod tests {
                 )
                 .unwrap();
 
-                game.load_plugin_headers(&[Path::new(BLANK_ESM)]).unwrap();
-                assert!(game.plugin(BLANK_ESM).is_some());
-
-                assert!(
-                    game.load_plugin_headers(&[Path::new(NON_PLUGIN_FILE)])
-                        .is_err()
-                );
+                game.set_thread_count(NonZeroUsize::new(3)).unwrap();
+                game.set_thread_count(None).unwrap();
 
-                assert!(game.plugin(BLANK_ESM).is_some());
-                assert!(game.plugin(NON_PLUGIN_FILE).is_none());
+                assert!(game.thread_pool.is_none());
+            }
+        }
+
+        mod filter_valid_plugins {
+            use super::*;
+
+            use crate::tests::NON_PLUGIN_FILE;
+
+            #[test]
+            fn should_return_the_valid_plugins_in_the_given_order() {
+                let fixture = Fixture::new(GameType::Oblivion);
+
+                let game = Game::with_local_path(
+                    fixture.game_type,
+                    &fixture.game_path,
+                    &fixture.local_path,
+                )
+                .unwrap();
+
+                let paths = [
+                    Path::new(BLANK_ESP),
+                    Path::new(NON_PLUGIN_FILE),
+                    Path::new("missing.esp"),
+                    Path::new(BLANK_ESM),
+                ];
+
+                assert_eq!(
+                    vec![Path::new(BLANK_ESP), Path::new(BLANK_ESM)],
+                    game.filter_valid_plugins(&paths)
+                );
+            }
+
+            #[test]
+            fn should_check_a_plugin_again_if_it_has_changed() {
+                let fixture = Fixture::new(GameType::Oblivion);
+
+                let game = Game::with_local_path(
+                    fixture.game_type,
+                    &fixture.game_path,
+                    &fixture.local_path,
+                )
+                .unwrap();
+
+                let paths = [Path::new(BLANK_ESP)];
+
+                assert_eq!(
+                    vec![Path::new(BLANK_ESP)],
+                    game.filter_valid_plugins(&paths)
+                );
+
+                std::fs::write(fixture.data_path().join(BLANK_ESP), "invalid").unwrap();
+
+                assert!(game.filter_valid_plugins(&paths).is_empty());
+                assert!(!game.is_valid_plugin(Path::new(BLANK_ESP)));
+            }
+        }
+
+        mod load_plugin_headers {
+            use crate::tests::NON_PLUGIN_FILE;
+
+            use super::*;
+
+            #[parameterized_test(ALL_GAME_TYPES)]
+            fn should_load_the_headers_of_the_given_plugins(game_type: GameType) {
+                let fixture = Fixture::new(game_type);
+
+                let mut game = Game::with_local_path(
+                    fixture.game_type,
+                    &fixture.game_path,
+                    &fixture.local_path,
+                )
+                .unwrap();
+
+                assert!(game.plugin(BLANK_ESM).is_none());
+                assert!(game.plugin(BLANK_DIFFERENT_ESM).is_none());
+                assert!(game.plugin(BLANK_ESP).is_none());
+
+                game.load_plugin_headers(&[Path::new(BLANK_ESM), Path::new(BLANK_ESP)])
+                    .unwrap();
+
+                let plugin = game.plugin(BLANK_ESM).unwrap();
+                assert_eq!("5.0", plugin.version().unwrap());
+                assert!(plugin.crc().is_none());
+
+                assert!(game.plugin(BLANK_DIFFERENT_ESM).is_none());
+                assert!(game.plugin(BLANK_ESP).is_some());
+            }
+
+            #[test]
+            fn should_not_modify_loaded_plugins_storage_if_given_a_non_plugin() {
+                let fixture = Fixture::new(GameType::Morrowind);
+
+                let mut game = Game::with_local_path(
+                    fixture.game_type,
+                    &fixture.game_path,
+                    &fixture.local_path,
+                )
+                .unwrap();
+
+                game.load_plugin_headers(&[Path::new(BLANK_ESM)]).unwrap();
+                assert!(game.plugin(BLANK_ESM).is_some());
+
+                assert!(
+                    game.load_plugin_headers(&[Path::new(NON_PLUGIN_FILE)])
+                        .is_err()
+                );
+
+                assert!(game.plugin(BLANK_ESM).is_some());
+                assert!(game.plugin(NON_PLUGIN_FILE).is_none());
             }
 
             #[test]
@@ -1684,11 +2484,58 @@ mod tests {
 
                 assert!(game.plugin(BLANK_MASTER_DEPENDENT_ESM).is_some());
             }
+
+            #[parameterized_test(ALL_GAME_TYPES)]
+            fn should_not_reuse_esplugin_metadata_of_plugins_that_are_no_longer_loaded(
+                game_type: GameType,
+            ) {
+                let fixture = Fixture::new(game_type);
+
+                let mut game = Game::with_local_path(
+                    fixture.game_type,
+                    &fixture.game_path,
+                    &fixture.local_path,
+                )
+                .unwrap();
+
+                let master = if game_type == GameType::Starfield {
+                    BLANK_FULL_ESM
+                } else {
+                    BLANK_ESM
+                };
+
+                game.load_plugins(&[Path::new(master)]).unwrap();
+                game.load_plugins(&[Path::new(BLANK_MASTER_DEPENDENT_ESM)])
+                    .unwrap();
+
+                let resolves_record_ids = matches!(
+                    game_type,
+                    GameType::Morrowind | GameType::OpenMW | GameType::Starfield
+                );
+                assert_eq!(
+                    resolves_record_ids,
+                    game.cache
+                        .plugins_metadata
+                        .0
+                        .contains_key(&Filename::new(master.to_owned()))
+                );
+
+                game.clear_loaded_plugins();
+
+                assert!(game.cache.plugins_metadata.0.is_empty());
+                assert_eq!(
+                    resolves_record_ids,
+                    game.load_plugins(&[Path::new(BLANK_MASTER_DEPENDENT_ESM)])
+                        .is_err()
+                );
+            }
         }
 
         mod load_plugins_common {
             use super::*;
 
+            use crate::tests::NON_PLUGIN_FILE;
+
             #[parameterized_test(ALL_GAME_TYPES)]
             fn should_find_archives_in_additional_data_paths(game_type: GameType) {
                 let fixture = Fixture::new(game_type);
@@ -1807,6 +2654,60 @@ mod tests {
                 }
             }
 
+            #[test]
+            fn should_not_change_the_archive_cache_if_a_plugin_is_invalid() {
+                let fixture = Fixture::new(GameType::Oblivion);
+
+                let mut game = Game::with_local_path(
+                    fixture.game_type,
+                    &fixture.game_path,
+                    &fixture.local_path,
+                )
+                .unwrap();
+
+                game.load_plugins_common(&[], LoadScope::HeaderOnly)
+                    .unwrap();
+
+                std::fs::File::create(fixture.data_path().join("Blank.bsa")).unwrap();
+
+                let paths = [Path::new(BLANK_ESM), Path::new(NON_PLUGIN_FILE)];
+                let result = game.load_plugins_common(&paths, LoadScope::HeaderOnly);
+
+                assert!(matches!(
+                    result,
+                    Err(LoadPluginsError::PluginValidationError(_))
+                ));
+                assert!(game.cache.archive_paths.is_empty());
+            }
+
+            #[test]
+            fn should_error_given_a_plugin_with_an_invalid_header() {
+                let fixture = Fixture::new(GameType::Oblivion);
+
+                let mut game = Game::with_local_path(
+                    fixture.game_type,
+                    &fixture.game_path,
+                    &fixture.local_path,
+                )
+                .unwrap();
+
+                std::fs::write(fixture.data_path().join(BLANK_ESP), "invalid").unwrap();
+
+                let paths = [Path::new(BLANK_ESM), Path::new(BLANK_ESP)];
+
+                for load_scope in [LoadScope::HeaderOnly, LoadScope::WholePlugin] {
+                    match game.load_plugins_common(&paths, load_scope) {
+                        Err(LoadPluginsError::PluginValidationError(e)) => {
+                            assert!(
+                                e.to_string()
+                                    .contains("does not have a valid plugin header")
+                            );
+                        }
+                        _ => panic!("Expected an error due to an invalid plugin header"),
+                    }
+                }
+            }
+
             #[test]
             fn should_resolve_relative_paths_relative_to_the_data_path() {
                 let fixture = Fixture::new(GameType::Oblivion);
@@ -1940,25 +2841,39 @@ mod tests {
             }
 
             #[test]
-            fn should_error_if_a_given_plugin_is_not_loaded() {
+            fn should_reuse_a_cached_result_if_the_inputs_are_unchanged() {
                 let fixture = Fixture::new(GameType::Oblivion);
+                let cache_path = fixture.local_path.join("sort-cache.txt");
 
-                let game = Game::with_local_path(
+                let mut game = Game::with_local_path(
                     fixture.game_type,
                     &fixture.game_path,
                     &fixture.local_path,
                 )
                 .unwrap();
 
-                assert!(game.sort_plugins(&[BLANK_ESP]).is_err());
-            }
-        }
+                load_all_installed_plugins(&mut game, &fixture);
+                game.enable_sort_result_cache(Some(cache_path.clone()));
 
-        mod is_plugin_active {
-            use super::*;
+                let input = &[BLANK_ESP, BLANK_DIFFERENT_ESP];
+                let sorted = game.sort_plugins(input).unwrap();
+
+                assert_eq!(sorted, game.sort_plugins(input).unwrap());
+
+                let mut metadata = PluginMetadata::new(BLANK_ESP).unwrap();
+                metadata.set_load_after_files(vec![File::new(BLANK_DIFFERENT_ESP.to_owned())]);
+                game.database()
+                    .write()
+                    .unwrap()
+                    .set_plugin_user_metadata(metadata);
+
+                let sorted = game.sort_plugins(input).unwrap();
+
+                assert_eq!(&[BLANK_DIFFERENT_ESP, BLANK_ESP], sorted.as_slice());
+            }
 
             #[test]
-            fn should_be_independent_of_plugins_being_loaded() {
+            fn should_use_the_given_tie_break_strategy() {
                 let fixture = Fixture::new(GameType::Oblivion);
 
                 let mut game = Game::with_local_path(
@@ -1968,78 +2883,665 @@ mod tests {
                 )
                 .unwrap();
 
-                game.load_current_load_order_state().unwrap();
-
-                assert!(game.is_plugin_active(BLANK_ESM));
-                assert!(!game.is_plugin_active(BLANK_ESP));
+                load_all_installed_plugins(&mut game, &fixture);
+                game.set_tie_break_strategy(TieBreakStrategy::LoadOrderPriority);
 
-                let paths = &[Path::new(BLANK_ESM), Path::new(BLANK_ESP)];
-                game.load_plugin_headers(paths).unwrap();
+                let input = &[BLANK_ESP, BLANK_DIFFERENT_ESP];
+                assert_eq!(input, game.sort_plugins(input).unwrap().as_slice());
 
-                assert!(game.is_plugin_active(BLANK_ESM));
-                assert!(!game.is_plugin_active(BLANK_ESP));
+                let mut metadata = PluginMetadata::new(BLANK_ESP).unwrap();
+                metadata.set_load_after_files(vec![File::new(BLANK_DIFFERENT_ESP.to_owned())]);
+                game.database()
+                    .write()
+                    .unwrap()
+                    .set_plugin_user_metadata(metadata);
 
-                game.load_plugins(paths).unwrap();
+                let sorted = game.sort_plugins(input).unwrap();
 
-                assert!(game.is_plugin_active(BLANK_ESM));
-                assert!(!game.is_plugin_active(BLANK_ESP));
+                assert_eq!(&[BLANK_DIFFERENT_ESP, BLANK_ESP], sorted.as_slice());
             }
-        }
 
-        #[test]
-        fn set_load_order_should_persist_the_given_load_order() {
-            let fixture = Fixture::new(GameType::Oblivion);
+            #[test]
+            fn should_read_cached_results_from_the_given_path() {
+                let fixture = Fixture::new(GameType::Oblivion);
+                let cache_path = fixture.local_path.join("sort-cache.txt");
 
-            let mut game =
-                Game::with_local_path(fixture.game_type, &fixture.game_path, &fixture.local_path)
-                    .unwrap();
+                let mut game = Game::with_local_path(
+                    fixture.game_type,
+                    &fixture.game_path,
+                    &fixture.local_path,
+                )
+                .unwrap();
 
-            game.load_current_load_order_state().unwrap();
+                load_all_installed_plugins(&mut game, &fixture);
+                game.enable_sort_result_cache(Some(cache_path.clone()));
 
-            let mut load_order: Vec<_> =
-                game.load_order().iter().map(ToString::to_string).collect();
-            load_order.swap(7, 10);
-            let load_order: Vec<_> = load_order.iter().map(String::as_str).collect();
+                let input = &[BLANK_ESP, BLANK_DIFFERENT_ESP];
+                let sorted = game.sort_plugins(input).unwrap();
 
-            game.set_load_order(&load_order).unwrap();
+                assert!(!cache_path.exists());
 
-            let mut game =
-                Game::with_local_path(fixture.game_type, &fixture.game_path, &fixture.local_path)
-                    .unwrap();
+                game.flush_sort_result_cache().unwrap();
 
-            game.load_current_load_order_state().unwrap();
+                assert!(cache_path.exists());
 
-            assert_eq!(load_order, game.load_order());
-        }
+                game.disable_sort_result_cache();
+                game.enable_sort_result_cache(Some(cache_path));
 
-        #[test]
-        fn should_support_loading_plugins_and_metadata_in_parallel() {
-            let fixture = Fixture::new(GameType::Morrowind);
+                assert_eq!(sorted, game.sort_plugins(input).unwrap());
+            }
 
-            let mut game =
-                Game::with_local_path(fixture.game_type, &fixture.game_path, &fixture.local_path)
-                    .unwrap();
+            #[test]
+            fn should_return_a_cached_result_without_sorting() {
+                let fixture = Fixture::new(GameType::Oblivion);
+                let cache_path = fixture.local_path.join("sort-cache.txt");
 
-            let masterlist_path = fixture.local_path.join("masterlist.yaml");
-            std::fs::write(&masterlist_path, "bash_tags: [Relev]").unwrap();
+                let mut game = Game::with_local_path(
+                    fixture.game_type,
+                    &fixture.game_path,
+                    &fixture.local_path,
+                )
+                .unwrap();
 
-            std::thread::scope(|s| {
-                let database = game.database();
-                s.spawn(move || {
-                    if let Ok(mut database) = database.write() {
-                        database.load_masterlist(&masterlist_path).unwrap();
-                    }
-                });
-                s.spawn(|| {
-                    game.load_plugins(&[]).unwrap();
-                });
-            });
-        }
-    }
+                load_all_installed_plugins(&mut game, &fixture);
+                game.enable_sort_result_cache(Some(cache_path.clone()));
 
-    #[test]
-    fn to_plugin_sorting_data_should_filter_out_files_with_false_constraints() {
-        let game_type = GameType::Oblivion;
+                let input = &[BLANK_ESP, BLANK_DIFFERENT_ESP];
+                assert_eq!(input, game.sort_plugins(input).unwrap().as_slice());
+
+                game.flush_sort_result_cache().unwrap();
+
+                // Replace the cached result with one that sorting wouldn't
+                // give, so that it's only returned if sorting is skipped.
+                let contents = std::fs::read_to_string(&cache_path).unwrap();
+                let expected_line = format!("{BLANK_ESP}/{BLANK_DIFFERENT_ESP}");
+                assert!(contents.contains(&expected_line));
+                let contents = contents.replace(
+                    &expected_line,
+                    &format!("{BLANK_DIFFERENT_ESP}/{BLANK_ESP}"),
+                );
+                std::fs::write(&cache_path, contents).unwrap();
+
+                game.enable_sort_result_cache(Some(cache_path));
+
+                assert_eq!(
+                    &[BLANK_DIFFERENT_ESP, BLANK_ESP],
+                    game.sort_plugins(input).unwrap().as_slice()
+                );
+            }
+
+            #[test]
+            fn should_error_if_a_given_plugin_is_not_loaded() {
+                let fixture = Fixture::new(GameType::Oblivion);
+
+                let game = Game::with_local_path(
+                    fixture.game_type,
+                    &fixture.game_path,
+                    &fixture.local_path,
+                )
+                .unwrap();
+
+                assert!(game.sort_plugins(&[BLANK_ESP]).is_err());
+            }
+        }
+
+        mod sort_session {
+            use crate::tests::initial_load_order;
+
+            use super::*;
+
+            fn load_game(fixture: &Fixture) -> Game {
+                let mut game = Game::with_local_path(
+                    fixture.game_type,
+                    &fixture.game_path,
+                    &fixture.local_path,
+                )
+                .unwrap();
+
+                let load_order = initial_load_order(fixture.game_type);
+                let plugins: Vec<_> = load_order.iter().map(|(n, _)| Path::new(n)).collect();
+
+                game.load_current_load_order_state().unwrap();
+                game.load_plugins(&plugins).unwrap();
+
+                game
+            }
+
+            fn plugin_names(fixture: &Fixture) -> Vec<&'static str> {
+                initial_load_order(fixture.game_type)
+                    .into_iter()
+                    .map(|(n, _)| n)
+                    .collect()
+            }
+
+            #[test]
+            fn start_sort_session_should_give_the_same_result_as_sort_plugins() {
+                let fixture = Fixture::new(GameType::Oblivion);
+                let game = load_game(&fixture);
+                let plugin_names = plugin_names(&fixture);
+
+                let session = game.start_sort_session(&plugin_names).unwrap();
+
+                assert_eq!(plugin_names, session.plugin_names());
+                assert_eq!(
+                    game.sort_plugins(&plugin_names).unwrap(),
+                    session.sorted_load_order()
+                );
+            }
+
+            #[test]
+            fn resort_plugins_should_give_the_same_result_as_sort_plugins_after_metadata_changes() {
+                let fixture = Fixture::new(GameType::Oblivion);
+                let game = load_game(&fixture);
+                let plugin_names = plugin_names(&fixture);
+
+                let mut session = game.start_sort_session(&plugin_names).unwrap();
+
+                let mut metadata = PluginMetadata::new(BLANK_ESP).unwrap();
+                metadata.set_load_after_files(vec![File::new(BLANK_DIFFERENT_ESP.to_owned())]);
+                game.database()
+                    .write()
+                    .unwrap()
+                    .set_plugin_user_metadata(metadata);
+
+                let sorted = game.resort_plugins(&mut session, &[]).unwrap();
+
+                assert_eq!(game.sort_plugins(&plugin_names).unwrap(), sorted);
+                let esp_position = sorted.iter().position(|n| n == BLANK_ESP).unwrap();
+                let different_esp_position = sorted
+                    .iter()
+                    .position(|n| n == BLANK_DIFFERENT_ESP)
+                    .unwrap();
+                assert!(different_esp_position < esp_position);
+            }
+
+            #[test]
+            fn resort_plugins_should_give_the_same_result_as_sort_plugins_after_plugins_are_added_and_removed()
+             {
+                let fixture = Fixture::new(GameType::Oblivion);
+                let game = load_game(&fixture);
+                let mut plugin_names = plugin_names(&fixture);
+                let removed = plugin_names.remove(1);
+
+                let mut session = game.start_sort_session(&plugin_names).unwrap();
+
+                let sorted = game
+                    .resort_plugins(
+                        &mut session,
+                        &[
+                            SortSessionChange::PluginRemoved(BLANK_ESP.to_owned()),
+                            SortSessionChange::PluginAdded(removed.to_owned()),
+                        ],
+                    )
+                    .unwrap();
+
+                plugin_names.retain(|n| *n != BLANK_ESP);
+                plugin_names.push(removed);
+
+                assert_eq!(plugin_names, session.plugin_names());
+                assert_eq!(game.sort_plugins(&plugin_names).unwrap(), sorted);
+            }
+
+            #[test]
+            fn resort_plugins_should_give_the_same_result_as_sort_plugins_after_a_plugin_is_reloaded()
+             {
+                let fixture = Fixture::new(GameType::Oblivion);
+                let mut game = load_game(&fixture);
+                let plugin_names = plugin_names(&fixture);
+
+                let mut session = game.start_sort_session(&plugin_names).unwrap();
+
+                game.load_plugin_headers(&[Path::new(BLANK_ESM)]).unwrap();
+
+                let sorted = game.resort_plugins(&mut session, &[]).unwrap();
+
+                assert_eq!(game.sort_plugins(&plugin_names).unwrap(), sorted);
+            }
+
+            #[test]
+            fn resort_plugins_should_error_if_an_added_plugin_is_not_loaded() {
+                let fixture = Fixture::new(GameType::Oblivion);
+                let game = load_game(&fixture);
+                let plugin_names = plugin_names(&fixture);
+
+                let mut session = game.start_sort_session(&plugin_names).unwrap();
+
+                let result = game.resort_plugins(
+                    &mut session,
+                    &[SortSessionChange::PluginAdded("missing.esp".to_owned())],
+                );
+
+                assert!(result.is_err());
+            }
+
+            #[test]
+            fn resort_plugins_should_leave_the_session_usable_if_sorting_fails() {
+                let fixture = Fixture::new(GameType::Oblivion);
+                let game = load_game(&fixture);
+                let plugin_names = plugin_names(&fixture);
+
+                let mut session = game.start_sort_session(&plugin_names).unwrap();
+                let sorted = session.sorted_load_order().to_vec();
+
+                let result = game.resort_plugins(
+                    &mut session,
+                    &[
+                        SortSessionChange::PluginRemoved(BLANK_ESP.to_owned()),
+                        SortSessionChange::PluginAdded("missing.esp".to_owned()),
+                    ],
+                );
+
+                assert!(result.is_err());
+                assert_eq!(plugin_names, session.plugin_names());
+                assert_eq!(sorted, session.sorted_load_order());
+
+                let mut metadata = PluginMetadata::new(BLANK_ESP).unwrap();
+                metadata.set_load_after_files(vec![File::new(BLANK_DIFFERENT_ESP.to_owned())]);
+                let mut other_metadata = PluginMetadata::new(BLANK_DIFFERENT_ESP).unwrap();
+                other_metadata.set_load_after_files(vec![File::new(BLANK_ESP.to_owned())]);
+                {
+                    let mut database = game.database().write().unwrap();
+                    database.set_plugin_user_metadata(metadata);
+                    database.set_plugin_user_metadata(other_metadata);
+                }
+
+                assert!(game.resort_plugins(&mut session, &[]).is_err());
+                assert_eq!(plugin_names, session.plugin_names());
+
+                game.database().write().unwrap().discard_all_user_metadata();
+
+                assert_eq!(
+                    game.sort_plugins(&plugin_names).unwrap(),
+                    game.resort_plugins(&mut session, &[]).unwrap()
+                );
+            }
+        }
+
+        mod load_current_load_order_state {
+            use super::*;
+
+            fn evaluate(game: &Game, condition: &str) -> bool {
+                game.database().read().unwrap().evaluate(condition).unwrap()
+            }
+
+            #[test]
+            fn should_pick_up_changes_to_the_active_plugins_file() {
+                let fixture = Fixture::new(GameType::Oblivion);
+
+                let mut game = Game::with_local_path(
+                    fixture.game_type,
+                    &fixture.game_path,
+                    &fixture.local_path,
+                )
+                .unwrap();
+
+                game.load_current_load_order_state().unwrap();
+
+                let condition = format!("active(\"{BLANK_ESP}\")");
+                assert!(!game.is_plugin_active(BLANK_ESP));
+                assert!(!evaluate(&game, &condition));
+
+                let plugins_path = fixture.local_path.join("Plugins.txt");
+                let mut plugins = std::fs::read_to_string(&plugins_path).unwrap();
+                plugins.push_str(BLANK_ESP);
+                plugins.push('\n');
+                std::fs::write(&plugins_path, plugins).unwrap();
+
+                game.load_current_load_order_state().unwrap();
+
+                assert!(game.is_plugin_active(BLANK_ESP));
+                assert!(evaluate(&game, &condition));
+            }
+
+            #[test]
+            fn should_clear_the_condition_cache_if_a_plugin_directory_changed() {
+                let fixture = Fixture::new(GameType::Oblivion);
+
+                let mut game = Game::with_local_path(
+                    fixture.game_type,
+                    &fixture.game_path,
+                    &fixture.local_path,
+                )
+                .unwrap();
+
+                game.load_current_load_order_state().unwrap();
+
+                let condition = "file(\"new.txt\")";
+                assert!(!evaluate(&game, condition));
+
+                std::fs::write(fixture.data_path().join("new.txt"), "").unwrap();
+
+                game.load_current_load_order_state().unwrap();
+
+                assert!(evaluate(&game, condition));
+            }
+
+            #[test]
+            fn should_clear_the_condition_cache_if_the_load_order_sources_are_unchanged() {
+                let fixture = Fixture::new(GameType::Oblivion);
+                let subdirectory = fixture.data_path().join("textures/sub");
+                std::fs::create_dir_all(&subdirectory).unwrap();
+
+                let mut game = Game::with_local_path(
+                    fixture.game_type,
+                    &fixture.game_path,
+                    &fixture.local_path,
+                )
+                .unwrap();
+
+                game.load_current_load_order_state().unwrap();
+
+                let condition = "file(\"textures/sub/new.dds\")";
+                assert!(!evaluate(&game, condition));
+
+                // Nested changes don't affect the plugin directory's entries,
+                // so the load order isn't reloaded, but conditions must still
+                // be evaluated again.
+                std::fs::write(subdirectory.join("new.dds"), "").unwrap();
+
+                game.load_current_load_order_state().unwrap();
+
+                assert!(evaluate(&game, condition));
+            }
+        }
+
+        mod is_plugin_active {
+            use super::*;
+
+            #[test]
+            fn should_be_independent_of_plugins_being_loaded() {
+                let fixture = Fixture::new(GameType::Oblivion);
+
+                let mut game = Game::with_local_path(
+                    fixture.game_type,
+                    &fixture.game_path,
+                    &fixture.local_path,
+                )
+                .unwrap();
+
+                game.load_current_load_order_state().unwrap();
+
+                assert!(game.is_plugin_active(BLANK_ESM));
+                assert!(!game.is_plugin_active(BLANK_ESP));
+
+                let paths = &[Path::new(BLANK_ESM), Path::new(BLANK_ESP)];
+                game.load_plugin_headers(paths).unwrap();
+
+                assert!(game.is_plugin_active(BLANK_ESM));
+                assert!(!game.is_plugin_active(BLANK_ESP));
+
+                game.load_plugins(paths).unwrap();
+
+                assert!(game.is_plugin_active(BLANK_ESM));
+                assert!(!game.is_plugin_active(BLANK_ESP));
+            }
+        }
+
+        #[test]
+        fn is_plugin_active_should_be_case_insensitive() {
+            let fixture = Fixture::new(GameType::Oblivion);
+
+            let mut game =
+                Game::with_local_path(fixture.game_type, &fixture.game_path, &fixture.local_path)
+                    .unwrap();
+
+            game.load_current_load_order_state().unwrap();
+
+            assert!(game.is_plugin_active(&BLANK_ESM.to_uppercase()));
+            assert!(!game.is_plugin_active(&BLANK_ESP.to_uppercase()));
+        }
+
+        #[test]
+        fn load_order_snapshot_should_be_shared_until_the_load_order_is_changed() {
+            let fixture = Fixture::new(GameType::Oblivion);
+
+            let mut game =
+                Game::with_local_path(fixture.game_type, &fixture.game_path, &fixture.local_path)
+                    .unwrap();
+
+            game.load_current_load_order_state().unwrap();
+
+            let snapshot = game.load_order_snapshot();
+            assert!(Arc::ptr_eq(&snapshot, &game.load_order_snapshot()));
+            assert_eq!(game.load_order(), snapshot.plugin_names());
+            assert!(snapshot.is_active(BLANK_ESM));
+
+            let mut load_order: Vec<_> =
+                snapshot.plugin_names().iter().map(String::as_str).collect();
+            load_order.swap(7, 10);
+            game.set_load_order(&load_order).unwrap();
+
+            let new_snapshot = game.load_order_snapshot();
+            assert!(!Arc::ptr_eq(&snapshot, &new_snapshot));
+            assert_eq!(load_order, new_snapshot.plugin_names());
+        }
+
+        mod move_plugins {
+            use super::*;
+
+            fn moved_load_order(game: &Game, plugin: &str, before: &str) -> Vec<String> {
+                let mut load_order: Vec<_> =
+                    game.load_order().iter().map(ToString::to_string).collect();
+                load_order.retain(|n| n != plugin);
+                let position = load_order.iter().position(|n| n == before).unwrap();
+                load_order.insert(position, plugin.to_owned());
+                load_order
+            }
+
+            #[test]
+            fn should_not_write_the_load_order_until_it_is_flushed() {
+                let fixture = Fixture::new(GameType::Oblivion);
+
+                let mut game = Game::with_local_path(
+                    fixture.game_type,
+                    &fixture.game_path,
+                    &fixture.local_path,
+                )
+                .unwrap();
+
+                game.load_current_load_order_state().unwrap();
+                let initial_load_order: Vec<_> =
+                    game.load_order().iter().map(ToString::to_string).collect();
+
+                let expected = moved_load_order(
+                    &game,
+                    BLANK_DIFFERENT_PLUGIN_DEPENDENT_ESP,
+                    BLANK_MASTER_DEPENDENT_ESP,
+                );
+                let position = expected
+                    .iter()
+                    .position(|n| n == BLANK_DIFFERENT_PLUGIN_DEPENDENT_ESP)
+                    .unwrap();
+
+                game.move_plugins(&[(BLANK_DIFFERENT_PLUGIN_DEPENDENT_ESP, position)])
+                    .unwrap();
+
+                assert_eq!(expected, game.load_order());
+
+                let mut other_game = Game::with_local_path(
+                    fixture.game_type,
+                    &fixture.game_path,
+                    &fixture.local_path,
+                )
+                .unwrap();
+                other_game.load_current_load_order_state().unwrap();
+
+                assert_eq!(initial_load_order, other_game.load_order());
+
+                game.flush_load_order().unwrap();
+
+                other_game.load_current_load_order_state().unwrap();
+
+                assert_eq!(expected, other_game.load_order());
+            }
+
+            #[test]
+            fn should_not_apply_any_moves_if_one_is_invalid() {
+                let fixture = Fixture::new(GameType::Oblivion);
+
+                let mut game = Game::with_local_path(
+                    fixture.game_type,
+                    &fixture.game_path,
+                    &fixture.local_path,
+                )
+                .unwrap();
+
+                game.load_current_load_order_state().unwrap();
+                let initial_load_order: Vec<_> =
+                    game.load_order().iter().map(ToString::to_string).collect();
+
+                let expected = moved_load_order(
+                    &game,
+                    BLANK_DIFFERENT_PLUGIN_DEPENDENT_ESP,
+                    BLANK_MASTER_DEPENDENT_ESP,
+                );
+                let position = expected
+                    .iter()
+                    .position(|n| n == BLANK_DIFFERENT_PLUGIN_DEPENDENT_ESP)
+                    .unwrap();
+
+                let result = game.move_plugins(&[
+                    (BLANK_DIFFERENT_PLUGIN_DEPENDENT_ESP, position),
+                    (BLANK_ESP, 0),
+                ]);
+
+                assert!(result.is_err());
+                assert_eq!(initial_load_order, game.load_order());
+            }
+
+            #[test]
+            fn should_not_load_the_load_order_state_while_there_are_unwritten_moves() {
+                let fixture = Fixture::new(GameType::Oblivion);
+
+                let mut game = Game::with_local_path(
+                    fixture.game_type,
+                    &fixture.game_path,
+                    &fixture.local_path,
+                )
+                .unwrap();
+
+                game.load_current_load_order_state().unwrap();
+
+                let expected = moved_load_order(
+                    &game,
+                    BLANK_DIFFERENT_PLUGIN_DEPENDENT_ESP,
+                    BLANK_MASTER_DEPENDENT_ESP,
+                );
+                let position = expected
+                    .iter()
+                    .position(|n| n == BLANK_DIFFERENT_PLUGIN_DEPENDENT_ESP)
+                    .unwrap();
+
+                game.move_plugins(&[(BLANK_DIFFERENT_PLUGIN_DEPENDENT_ESP, position)])
+                    .unwrap();
+
+                assert!(matches!(
+                    game.load_current_load_order_state(),
+                    Err(LoadOrderStateError::UnflushedChanges)
+                ));
+                assert_eq!(expected, game.load_order());
+
+                game.flush_load_order().unwrap();
+                game.load_current_load_order_state().unwrap();
+
+                assert_eq!(expected, game.load_order());
+            }
+
+            #[test]
+            fn should_not_write_unflushed_moves_when_the_game_is_dropped() {
+                let fixture = Fixture::new(GameType::Oblivion);
+
+                let mut game = Game::with_local_path(
+                    fixture.game_type,
+                    &fixture.game_path,
+                    &fixture.local_path,
+                )
+                .unwrap();
+
+                game.load_current_load_order_state().unwrap();
+                let initial_load_order: Vec<_> =
+                    game.load_order().iter().map(ToString::to_string).collect();
+
+                let expected = moved_load_order(
+                    &game,
+                    BLANK_DIFFERENT_PLUGIN_DEPENDENT_ESP,
+                    BLANK_MASTER_DEPENDENT_ESP,
+                );
+                let position = expected
+                    .iter()
+                    .position(|n| n == BLANK_DIFFERENT_PLUGIN_DEPENDENT_ESP)
+                    .unwrap();
+
+                game.move_plugins(&[(BLANK_DIFFERENT_PLUGIN_DEPENDENT_ESP, position)])
+                    .unwrap();
+                drop(game);
+
+                let mut other_game = Game::with_local_path(
+                    fixture.game_type,
+                    &fixture.game_path,
+                    &fixture.local_path,
+                )
+                .unwrap();
+                other_game.load_current_load_order_state().unwrap();
+
+                assert_eq!(initial_load_order, other_game.load_order());
+            }
+        }
+
+        #[test]
+        fn set_load_order_should_persist_the_given_load_order() {
+            let fixture = Fixture::new(GameType::Oblivion);
+
+            let mut game =
+                Game::with_local_path(fixture.game_type, &fixture.game_path, &fixture.local_path)
+                    .unwrap();
+
+            game.load_current_load_order_state().unwrap();
+
+            let mut load_order: Vec<_> =
+                game.load_order().iter().map(ToString::to_string).collect();
+            load_order.swap(7, 10);
+            let load_order: Vec<_> = load_order.iter().map(String::as_str).collect();
+
+            game.set_load_order(&load_order).unwrap();
+
+            let mut game =
+                Game::with_local_path(fixture.game_type, &fixture.game_path, &fixture.local_path)
+                    .unwrap();
+
+            game.load_current_load_order_state().unwrap();
+
+            assert_eq!(load_order, game.load_order());
+        }
+
+        #[test]
+        fn should_support_loading_plugins_and_metadata_in_parallel() {
+            let fixture = Fixture::new(GameType::Morrowind);
+
+            let mut game =
+                Game::with_local_path(fixture.game_type, &fixture.game_path, &fixture.local_path)
+                    .unwrap();
+
+            let masterlist_path = fixture.local_path.join("masterlist.yaml");
+            std::fs::write(&masterlist_path, "bash_tags: [Relev]").unwrap();
+
+            std::thread::scope(|s| {
+                let database = game.database();
+                s.spawn(move || {
+                    if let Ok(mut database) = database.write() {
+                        database.load_masterlist(&masterlist_path).unwrap();
+                    }
+                });
+                s.spawn(|| {
+                    game.load_plugins(&[]).unwrap();
+                });
+            });
+        }
+    }
+
+    #[test]
+    fn to_plugin_sorting_data_should_filter_out_files_with_false_constraints() {
+        let game_type = GameType::Oblivion;
         let true_constraint = "file(\"Blank.esm\")";
         let false_constraint = "file(\"missing.esm\")";
 
@@ -2089,6 +3591,36 @@ mod tests {
         assert_eq!([BLANK_DIFFERENT_ESP.to_owned()], *data.user_req);
     }
 
+    mod map_largest_first {
+        use super::*;
+
+        #[test]
+        fn should_return_results_in_the_order_of_the_given_items() {
+            let items: Vec<u64> = (0..100).map(|i| (i * 37) & 127).collect();
+
+            let results = map_largest_first(&items, |i| *i, |i| i * 2);
+
+            let expected: Vec<_> = items.iter().map(|i| i * 2).collect();
+            assert_eq!(expected, results);
+        }
+
+        #[test]
+        fn should_map_the_largest_item_first() {
+            let items = [1, 5, 3];
+            let order = Mutex::new(Vec::new());
+
+            rayon::ThreadPoolBuilder::new()
+                .num_threads(1)
+                .build()
+                .unwrap()
+                .install(|| {
+                    map_largest_first(&items, |i| *i, |i| order.lock().unwrap().push(*i));
+                });
+
+            assert_eq!(vec![5, 3, 1], order.into_inner().unwrap());
+        }
+    }
+
     mod game_cache {
         use super::*;
 
@@ -124,10 +124,13 @@ use std::{path::Path, slice::EscapeAscii};
 use fancy_regex::{Error as RegexImplError, Regex, RegexBuilder};
 
 pub use database::{Database, WriteMode};
-pub use game::{Game, GameType};
+pub use game::{Game, GameType, LoadOrderSnapshot, SortSession, SortSessionChange};
 pub use logging::{LogLevel, set_log_level, set_logging_callback};
-pub use plugin::Plugin;
-pub use sorting::vertex::{EdgeType, Vertex};
+pub use plugin::{Plugin, summary as plugin_summary};
+pub use sorting::{
+    plugins::TieBreakStrategy,
+    vertex::{EdgeType, Vertex},
+};
 pub use version::{
     LIBLOOT_VERSION_MAJOR, LIBLOOT_VERSION_MINOR, LIBLOOT_VERSION_PATCH, is_compatible,
     libloot_revision, libloot_version,
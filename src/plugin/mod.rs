@@ -1,4 +1,5 @@
 pub mod error;
+pub mod summary;
 
 use std::{
     collections::{BTreeMap, BTreeSet},
@@ -6,7 +7,7 @@ use std::{
     hash::Hasher,
     io::{BufRead, BufReader},
     path::{Path, PathBuf},
-    sync::LazyLock,
+    sync::{LazyLock, OnceLock},
 };
 
 use esplugin::ParseOptions;
@@ -14,9 +15,9 @@ use fancy_regex::{Error as RegexImplError, Regex};
 
 use crate::{
     GameType,
-    archive::{assets_in_archives, do_assets_overlap, find_associated_archives},
+    archive::{assets_in_archives, find_associated_archives},
     case_insensitive_regex, escape_ascii,
-    game::GameCache,
+    game::{FileStamp, GameCache, file_stamp},
     logging,
     metadata::plugin_metadata::trim_dot_ghost,
 };
@@ -46,7 +47,7 @@ pub struct Plugin {
     name: String,
     data: Option<esplugin::Plugin>,
     game_type: GameType,
-    crc: Option<u32>,
+    crc: Option<LazyCrc>,
     version: Option<String>,
     tags: Box<[String]>,
     archive_paths: Box<[PathBuf]>,
@@ -59,14 +60,29 @@ impl Plugin {
         game_cache: &GameCache,
         plugin_path: &Path,
         load_scope: LoadScope,
+    ) -> Result<Self, LoadPluginError> {
+        let archive_paths = find_associated_archives(game_type, game_cache, plugin_path);
+
+        Self::with_archive_paths(game_type, plugin_path, archive_paths, load_scope)
+    }
+
+    /// Like [Plugin::new], but takes the paths of the archives that the plugin
+    /// loads, for when they've already been found.
+    pub(crate) fn with_archive_paths(
+        game_type: GameType,
+        plugin_path: &Path,
+        associated_archive_paths: Vec<PathBuf>,
+        load_scope: LoadScope,
     ) -> Result<Self, LoadPluginError> {
         let name = name_string(game_type, plugin_path)?;
 
         let (parse_options, crc) = if load_scope == LoadScope::HeaderOnly {
             (ParseOptions::header_only(), None)
         } else {
-            let crc = calculate_crc(plugin_path)?;
-            (ParseOptions::whole_plugin(), Some(crc))
+            (
+                ParseOptions::whole_plugin(),
+                Some(LazyCrc::new(plugin_path.to_path_buf())),
+            )
         };
 
         let mut version = None;
@@ -83,8 +99,7 @@ impl Plugin {
                     version = extract_version(&description)?;
                 }
 
-                archive_paths =
-                    find_associated_archives(game_type, game_cache, plugin_path).into_boxed_slice();
+                archive_paths = associated_archive_paths.into_boxed_slice();
 
                 if load_scope == LoadScope::WholePlugin {
                     archive_assets = assets_in_archives(&archive_paths);
@@ -152,9 +167,24 @@ impl Plugin {
 
     /// Get the plugin's CRC-32 checksum.
     ///
-    /// This will be `None` if the plugin is not fully loaded.
+    /// This will be `None` if the plugin is not fully loaded. The checksum is
+    /// calculated the first time it is requested, and will also be `None` if
+    /// the plugin file could not be read or has changed since the plugin was
+    /// loaded. In that case, the checksum is calculated again the next time
+    /// it is requested.
     pub fn crc(&self) -> Option<u32> {
-        self.crc
+        self.crc.as_ref().and_then(LazyCrc::get)
+    }
+
+    /// Get the plugin's CRC-32 checksum if it has already been calculated.
+    pub(crate) fn cached_crc(&self) -> Option<u32> {
+        self.crc.as_ref().and_then(LazyCrc::get_if_calculated)
+    }
+
+    /// Get the modification time and size of the plugin file when it was
+    /// loaded. This will be `None` if the plugin is not fully loaded.
+    pub(crate) fn file_stamp(&self) -> Option<FileStamp> {
+        self.crc.as_ref().and_then(|c| c.stamp)
     }
 
     /// Check if the plugin is a master plugin.
@@ -246,6 +276,24 @@ impl Plugin {
         !self.archive_paths.is_empty()
     }
 
+    /// Get a bitmask of the plugin's properties, made up of the `FLAG_*`
+    /// constants defined in [plugin_summary](crate::plugin_summary).
+    pub fn summary_flags(&self) -> u32 {
+        [
+            (self.is_master(), summary::FLAG_MASTER),
+            (self.is_light_plugin(), summary::FLAG_LIGHT),
+            (self.is_medium_plugin(), summary::FLAG_MEDIUM),
+            (self.is_update_plugin(), summary::FLAG_UPDATE),
+            (self.is_blueprint_plugin(), summary::FLAG_BLUEPRINT),
+            (self.is_empty(), summary::FLAG_EMPTY),
+            (self.loads_archive(), summary::FLAG_LOADS_ARCHIVE),
+            (self.cached_crc().is_some(), summary::FLAG_HAS_CRC),
+        ]
+        .into_iter()
+        .filter(|(is_set, _)| *is_set)
+        .fold(0, |flags, (_, flag)| flags | flag)
+    }
+
     /// Check if two plugins contain a record with the same ID.
     ///
     /// FormIDs are compared for all games apart from Morrowind, which doesn't
@@ -258,6 +306,12 @@ impl Plugin {
         }
     }
 
+    /// Morrowind and OpenMW record IDs aren't namespaced by the plugin that
+    /// added them, unlike the FormIDs used by later games.
+    pub(crate) fn has_namespaced_record_ids(&self) -> bool {
+        !matches!(self.game_type, GameType::Morrowind | GameType::OpenMW)
+    }
+
     pub(crate) fn override_record_count(&self) -> Result<usize, PluginDataError> {
         self.data
             .as_ref()
@@ -268,8 +322,14 @@ impl Plugin {
         self.archive_assets.values().fold(0, |acc, e| acc + e.len())
     }
 
-    pub(crate) fn do_assets_overlap(&self, plugin: &Plugin) -> bool {
-        do_assets_overlap(&self.archive_assets, &plugin.archive_assets)
+    pub(crate) fn assets(&self) -> impl Iterator<Item = (u64, u64)> {
+        self.archive_assets
+            .iter()
+            .flat_map(|(folder_hash, file_hashes)| {
+                file_hashes
+                    .iter()
+                    .map(move |file_hash| (*folder_hash, *file_hash))
+            })
     }
 
     pub(crate) fn resolve_record_ids(
@@ -283,13 +343,17 @@ impl Plugin {
     }
 }
 
-pub(crate) fn validate_plugin_path_and_header(
+/// Check that the given path has a plugin file extension for the game,
+/// without reading the file.
+pub(crate) fn validate_plugin_path(
     game_type: GameType,
     plugin_path: &Path,
 ) -> Result<(), PluginValidationError> {
-    if game_type == GameType::OpenMW && has_ascii_extension(plugin_path, "omwscripts") {
+    if (game_type == GameType::OpenMW && has_ascii_extension(plugin_path, "omwscripts"))
+        || has_plugin_file_extension(game_type, plugin_path)
+    {
         Ok(())
-    } else if !has_plugin_file_extension(game_type, plugin_path) {
+    } else {
         logging::debug!(
             "The file \"{}\" is not a valid plugin",
             escape_ascii(plugin_path)
@@ -298,7 +362,17 @@ pub(crate) fn validate_plugin_path_and_header(
             plugin_path.into(),
             InvalidFilenameReason::UnsupportedFileExtension,
         ))
-    } else if esplugin::Plugin::is_valid(game_type.into(), plugin_path, ParseOptions::header_only())
+    }
+}
+
+pub(crate) fn validate_plugin_path_and_header(
+    game_type: GameType,
+    plugin_path: &Path,
+) -> Result<(), PluginValidationError> {
+    validate_plugin_path(game_type, plugin_path)?;
+
+    if (game_type == GameType::OpenMW && has_ascii_extension(plugin_path, "omwscripts"))
+        || esplugin::Plugin::is_valid(game_type.into(), plugin_path, ParseOptions::header_only())
     {
         Ok(())
     } else {
@@ -373,6 +447,74 @@ fn name_string(game_type: GameType, path: &Path) -> Result<String, LoadPluginErr
     }
 }
 
+/// A plugin file's CRC-32 checksum, which is calculated the first time that
+/// it is needed, because reading the whole of a large plugin file again can
+/// take a significant amount of time and the checksum often isn't used.
+#[derive(Clone, Debug)]
+struct LazyCrc {
+    path: PathBuf,
+    // The file's state when the plugin was loaded, to detect if the file
+    // has changed by the time the checksum is calculated.
+    stamp: Option<FileStamp>,
+    // Failures aren't stored, as they may be due to a temporary change to the
+    // file.
+    value: OnceLock<u32>,
+}
+
+impl LazyCrc {
+    fn new(path: PathBuf) -> Self {
+        Self {
+            stamp: file_stamp(&path),
+            path,
+            value: OnceLock::new(),
+        }
+    }
+
+    fn get(&self) -> Option<u32> {
+        if let Some(crc) = self.value.get() {
+            return Some(*crc);
+        }
+
+        let crc = self.calculate()?;
+        Some(*self.value.get_or_init(|| crc))
+    }
+
+    fn get_if_calculated(&self) -> Option<u32> {
+        self.value.get().copied()
+    }
+
+    fn calculate(&self) -> Option<u32> {
+        if self.stamp.is_none() || file_stamp(&self.path) != self.stamp {
+            logging::warn!(
+                "Unable to calculate the CRC of \"{}\" as it has changed since it was loaded",
+                escape_ascii(&self.path)
+            );
+            return None;
+        }
+
+        match calculate_crc(&self.path) {
+            Ok(crc) => Some(crc),
+            Err(e) => {
+                logging::error!(
+                    "Failed to calculate the CRC of \"{}\": {}",
+                    escape_ascii(&self.path),
+                    e
+                );
+                None
+            }
+        }
+    }
+}
+
+// Whether or not the checksum has been calculated yet doesn't affect equality.
+impl PartialEq for LazyCrc {
+    fn eq(&self, other: &Self) -> bool {
+        self.path == other.path && self.stamp == other.stamp
+    }
+}
+
+impl Eq for LazyCrc {}
+
 fn calculate_crc(path: &Path) -> std::io::Result<u32> {
     let file = File::open(path)?;
     let mut reader = BufReader::new(file);
@@ -518,6 +660,77 @@ mod tests {
             }
         }
 
+        #[test]
+        fn crc_should_not_be_calculated_until_it_is_requested() {
+            let path = source_plugins_path(GameType::Oblivion).join(BLANK_ESM);
+
+            let plugin = Plugin::new(
+                GameType::Oblivion,
+                &GameCache::default(),
+                &path,
+                LoadScope::WholePlugin,
+            )
+            .unwrap();
+
+            assert!(plugin.cached_crc().is_none());
+
+            let crc = plugin.crc().unwrap();
+
+            assert_eq!(Some(crc), plugin.cached_crc());
+        }
+
+        #[test]
+        fn crc_should_be_none_if_the_plugin_file_changed_after_loading() {
+            let tmp_dir = tempdir().unwrap();
+            let source_path = source_plugins_path(GameType::Oblivion).join(BLANK_ESM);
+            let path = tmp_dir.path().join(BLANK_ESM);
+
+            std::fs::copy(source_path, &path).unwrap();
+
+            let plugin = Plugin::new(
+                GameType::Oblivion,
+                &GameCache::default(),
+                &path,
+                LoadScope::WholePlugin,
+            )
+            .unwrap();
+
+            let mut file = File::options().append(true).open(&path).unwrap();
+            file.write_all(&[0]).unwrap();
+            drop(file);
+
+            assert!(plugin.crc().is_none());
+        }
+
+        #[test]
+        fn crc_should_be_calculated_if_the_plugin_file_is_restored_after_a_failure() {
+            let tmp_dir = tempdir().unwrap();
+            let source_path = source_plugins_path(GameType::Oblivion).join(BLANK_ESM);
+            let path = tmp_dir.path().join(BLANK_ESM);
+
+            std::fs::copy(source_path, &path).unwrap();
+
+            let plugin = Plugin::new(
+                GameType::Oblivion,
+                &GameCache::default(),
+                &path,
+                LoadScope::WholePlugin,
+            )
+            .unwrap();
+
+            let metadata = path.metadata().unwrap();
+            let mut file = File::options().append(true).open(&path).unwrap();
+            file.write_all(&[0]).unwrap();
+
+            assert!(plugin.crc().is_none());
+
+            file.set_len(metadata.len()).unwrap();
+            file.set_modified(metadata.modified().unwrap()).unwrap();
+            drop(file);
+
+            assert!(plugin.crc().is_some());
+        }
+
         #[test]
         fn new_should_handle_non_ascii_filenames_correctly() {
             let tmp_dir = tempdir().unwrap();
@@ -565,7 +778,7 @@ mod tests {
             }
 
             assert!(plugin.crc().is_none());
-            assert!(!plugin.do_assets_overlap(&plugin));
+            assert_eq!(0, plugin.assets().count());
             assert_eq!(0, plugin.asset_count());
             assert!(!plugin.do_records_overlap(&plugin).unwrap());
             assert_eq!(0, plugin.override_record_count().unwrap());
@@ -600,7 +813,7 @@ mod tests {
             )
             .unwrap();
 
-            assert!(!plugin.do_assets_overlap(&plugin));
+            assert_eq!(0, plugin.assets().count());
             assert_eq!(0, plugin.asset_count());
         }
 
@@ -649,7 +862,7 @@ mod tests {
             };
 
             assert_eq!(expected_crc, plugin.crc().unwrap());
-            assert!(!plugin.do_assets_overlap(&plugin));
+            assert_eq!(0, plugin.assets().count());
             assert_eq!(0, plugin.asset_count());
 
             if matches!(game_type, GameType::Morrowind | GameType::OpenMW) {
@@ -706,11 +919,11 @@ mod tests {
                 // The Starfield test data doesn't include a BA2 file.
                 assert!(!plugin.loads_archive());
                 assert_eq!(0, plugin.asset_count());
-                assert!(!plugin.do_assets_overlap(&plugin));
+                assert_eq!(0, plugin.assets().count());
             } else {
                 assert!(plugin.loads_archive());
                 assert_eq!(1, plugin.asset_count());
-                assert!(plugin.do_assets_overlap(&plugin));
+                assert_eq!(1, plugin.assets().count());
             }
         }
 
@@ -0,0 +1,205 @@
+//! Packed plugin summaries, which hold the flags, CRCs and names of many
+//! plugins in a single buffer, so that they can be passed across a language
+//! boundary without creating an object for each plugin.
+//!
+//! A packed summary is a sequence of little-endian u32 values that starts with
+//! the plugin count, followed by [`FIELD_COUNT`] values for each plugin: its
+//! flags, its CRC (0 if it isn't included), and the offset and length in bytes
+//! of its name. The UTF-8 names of all the plugins follow, concatenated, and
+//! name offsets are relative to the start of the names.
+use std::{num::TryFromIntError, sync::Arc};
+
+use rayon::iter::{IntoParallelRefIterator, ParallelIterator};
+
+use super::Plugin;
+
+/// Set if the plugin is a master plugin.
+pub const FLAG_MASTER: u32 = 1;
+/// Set if the plugin is a light plugin.
+pub const FLAG_LIGHT: u32 = 1 << 1;
+/// Set if the plugin is a medium plugin.
+pub const FLAG_MEDIUM: u32 = 1 << 2;
+/// Set if the plugin is an update plugin.
+pub const FLAG_UPDATE: u32 = 1 << 3;
+/// Set if the plugin is a blueprint plugin.
+pub const FLAG_BLUEPRINT: u32 = 1 << 4;
+/// Set if the plugin contains no records other than its header.
+pub const FLAG_EMPTY: u32 = 1 << 5;
+/// Set if the plugin loads an archive.
+pub const FLAG_LOADS_ARCHIVE: u32 = 1 << 6;
+/// Set if the plugin's summary includes its CRC. This is always set for fully
+/// loaded plugins if CRCs were requested when packing the summaries, and
+/// otherwise only if the CRC had already been calculated, e.g. by
+/// [Plugin::crc].
+pub const FLAG_HAS_CRC: u32 = 1 << 7;
+
+/// The number of u32 values written for each plugin in a packed summary.
+pub const FIELD_COUNT: usize = 4;
+
+/// Pack the given plugins' flags, CRCs and names into a single buffer, using
+/// the layout described in the [module documentation](self).
+///
+/// If `include_crcs` is true, the CRCs of fully loaded plugins that have not
+/// yet been calculated are calculated in parallel, which involves reading each
+/// of those plugin files. Otherwise, only CRCs that have already been
+/// calculated are included.
+///
+/// Fails if there are more plugins or name bytes than can be represented
+/// using u32 values.
+pub fn pack_plugin_summaries(
+    plugins: &[Arc<Plugin>],
+    include_crcs: bool,
+) -> Result<Vec<u8>, TryFromIntError> {
+    if include_crcs {
+        // The calculated CRCs are cached, so they're read back while packing.
+        plugins.par_iter().for_each(|p| {
+            p.crc();
+        });
+    }
+
+    let names_length: usize = plugins.iter().map(|p| p.name().len()).sum();
+    let header_length = size_of::<u32>() * (1 + FIELD_COUNT * plugins.len());
+
+    let mut buffer = Vec::with_capacity(header_length + names_length);
+    buffer.extend_from_slice(&u32::try_from(plugins.len())?.to_le_bytes());
+
+    let mut name_offset = 0;
+    for plugin in plugins {
+        let name_length = plugin.name().len();
+        let fields = [
+            plugin.summary_flags(),
+            plugin.cached_crc().unwrap_or(0),
+            u32::try_from(name_offset)?,
+            u32::try_from(name_length)?,
+        ];
+
+        for field in fields {
+            buffer.extend_from_slice(&field.to_le_bytes());
+        }
+
+        name_offset += name_length;
+    }
+
+    for plugin in plugins {
+        buffer.extend_from_slice(plugin.name().as_bytes());
+    }
+
+    Ok(buffer)
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    use crate::{
+        GameType,
+        game::GameCache,
+        plugin::LoadScope,
+        tests::{BLANK_ESM, BLANK_ESP, source_plugins_path},
+    };
+
+    fn load_plugin(name: &str, load_scope: LoadScope) -> Arc<Plugin> {
+        let path = source_plugins_path(GameType::Oblivion).join(name);
+
+        Arc::new(Plugin::new(GameType::Oblivion, &GameCache::default(), &path, load_scope).unwrap())
+    }
+
+    fn len_u32(name: &str) -> u32 {
+        u32::try_from(name.len()).unwrap()
+    }
+
+    fn read_u32(buffer: &[u8], index: usize) -> u32 {
+        let start = index * size_of::<u32>();
+        let bytes = buffer[start..start + size_of::<u32>()].try_into().unwrap();
+        u32::from_le_bytes(bytes)
+    }
+
+    mod summary_flags {
+        use super::*;
+
+        #[test]
+        fn should_set_the_bits_for_the_plugins_properties() {
+            let master = load_plugin(BLANK_ESM, LoadScope::HeaderOnly);
+            let non_master = load_plugin(BLANK_ESP, LoadScope::HeaderOnly);
+
+            assert_eq!(FLAG_MASTER, master.summary_flags() & FLAG_MASTER);
+            assert_eq!(0, non_master.summary_flags() & FLAG_MASTER);
+            assert_eq!(0, master.summary_flags() & FLAG_LIGHT);
+        }
+
+        #[test]
+        fn should_set_the_has_crc_bit_only_if_the_crc_has_been_calculated() {
+            let header_only = load_plugin(BLANK_ESM, LoadScope::HeaderOnly);
+            let whole = load_plugin(BLANK_ESM, LoadScope::WholePlugin);
+
+            assert!(header_only.crc().is_none());
+            assert_eq!(0, header_only.summary_flags() & FLAG_HAS_CRC);
+
+            assert_eq!(0, whole.summary_flags() & FLAG_HAS_CRC);
+            assert!(whole.cached_crc().is_none());
+
+            assert!(whole.crc().is_some());
+            assert_eq!(FLAG_HAS_CRC, whole.summary_flags() & FLAG_HAS_CRC);
+        }
+    }
+
+    mod pack_plugin_summaries {
+        use super::*;
+
+        #[test]
+        fn should_only_write_the_plugin_count_if_there_are_no_plugins() {
+            let buffer = pack_plugin_summaries(&[], true).unwrap();
+
+            assert_eq!(0u32.to_le_bytes().as_slice(), buffer.as_slice());
+        }
+
+        #[test]
+        fn should_write_each_plugins_fields_followed_by_the_names() {
+            let plugins = [
+                load_plugin(BLANK_ESM, LoadScope::WholePlugin),
+                load_plugin(BLANK_ESP, LoadScope::WholePlugin),
+            ];
+            let crc = plugins[0].crc().unwrap();
+
+            let buffer = pack_plugin_summaries(&plugins, false).unwrap();
+
+            let names_start = size_of::<u32>() * (1 + FIELD_COUNT * plugins.len());
+            assert_eq!(
+                names_start + BLANK_ESM.len() + BLANK_ESP.len(),
+                buffer.len()
+            );
+            assert_eq!(2, read_u32(&buffer, 0));
+
+            assert_eq!(plugins[0].summary_flags(), read_u32(&buffer, 1));
+            assert_eq!(crc, read_u32(&buffer, 2));
+            assert_eq!(0, read_u32(&buffer, 3));
+            assert_eq!(len_u32(BLANK_ESM), read_u32(&buffer, 4));
+
+            assert_eq!(plugins[1].summary_flags(), read_u32(&buffer, 5));
+            assert_eq!(0, read_u32(&buffer, 6));
+            assert!(plugins[1].cached_crc().is_none());
+            assert_eq!(len_u32(BLANK_ESM), read_u32(&buffer, 7));
+            assert_eq!(len_u32(BLANK_ESP), read_u32(&buffer, 8));
+
+            let names = std::str::from_utf8(&buffer[names_start..]).unwrap();
+            assert_eq!(format!("{BLANK_ESM}{BLANK_ESP}"), names);
+        }
+
+        #[test]
+        fn should_calculate_missing_crcs_if_crcs_are_included() {
+            let plugins = [
+                load_plugin(BLANK_ESM, LoadScope::WholePlugin),
+                load_plugin(BLANK_ESP, LoadScope::HeaderOnly),
+            ];
+
+            let buffer = pack_plugin_summaries(&plugins, true).unwrap();
+
+            let crc = plugins[0].cached_crc().unwrap();
+            assert_eq!(FLAG_HAS_CRC, read_u32(&buffer, 1) & FLAG_HAS_CRC);
+            assert_eq!(crc, read_u32(&buffer, 2));
+
+            assert_eq!(0, read_u32(&buffer, 5) & FLAG_HAS_CRC);
+            assert_eq!(0, read_u32(&buffer, 6));
+        }
+    }
+}
@@ -5,7 +5,6 @@ use petgraph::{
     graph::{EdgeReference, NodeIndex},
     visit::EdgeRef,
 };
-use rustc_hash::{FxHashMap as HashMap, FxHashSet as HashSet};
 
 use crate::{EdgeType, Vertex, logging};
 
@@ -29,46 +28,133 @@ pub trait BidirBfsVisitor {
     fn visit_intersection_node(&mut self, node: NodeIndex);
 }
 
+/// A map from node indices to values that can be cleared in constant time,
+/// for holding the state of searches that are run many times on the same
+/// graph. Node indices are dense, so values are stored in a vector indexed by
+/// node index. Each value is stamped with the generation in which it was
+/// inserted, and clearing the map starts a new generation, so values from
+/// earlier generations are treated as absent.
+#[derive(Clone, Debug)]
+pub struct NodeMap<T> {
+    entries: Vec<(u32, T)>,
+    generation: u32,
+}
+
+impl<T: Copy + Default> NodeMap<T> {
+    pub fn new() -> Self {
+        // Start at 1 so that the generation of padding entries is never current.
+        Self {
+            entries: Vec::new(),
+            generation: 1,
+        }
+    }
+
+    /// Get the value for the given node, or the default value if none has
+    /// been inserted since the map was last cleared.
+    pub fn get(&self, node_index: NodeIndex) -> T {
+        self.entries
+            .get(node_index.index())
+            .filter(|(generation, _)| *generation == self.generation)
+            .map_or_else(T::default, |(_, value)| *value)
+    }
+
+    pub fn insert(&mut self, node_index: NodeIndex, value: T) {
+        let index = node_index.index();
+        if index >= self.entries.len() {
+            self.entries.resize(index + 1, (0, T::default()));
+        }
+
+        if let Some(entry) = self.entries.get_mut(index) {
+            *entry = (self.generation, value);
+        }
+    }
+
+    pub fn clear(&mut self) {
+        self.generation = self.generation.wrapping_add(1);
+
+        if self.generation == 0 {
+            // Entries from the last time the generation had this value would
+            // otherwise look current, so the entries must really be reset.
+            self.entries.fill((0, T::default()));
+            self.generation = 1;
+        }
+    }
+}
+
+impl<T: Copy + Default> Default for NodeMap<T> {
+    fn default() -> Self {
+        Self::new()
+    }
+}
+
+pub type ColourMap = NodeMap<Colour>;
+
+/// Buffers that are reused between bidirectional breadth-first searches to
+/// avoid reallocating them for each search.
+#[derive(Clone, Debug, Default)]
+pub struct BidirBfsScratch {
+    forward_queue: VecDeque<NodeIndex>,
+    reverse_queue: VecDeque<NodeIndex>,
+    forward_visited: NodeMap<bool>,
+    reverse_visited: NodeMap<bool>,
+}
+
+impl BidirBfsScratch {
+    fn reset(&mut self, from_index: NodeIndex, to_index: NodeIndex) {
+        self.forward_queue.clear();
+        self.forward_queue.push_back(from_index);
+        self.reverse_queue.clear();
+        self.reverse_queue.push_back(to_index);
+
+        self.forward_visited.clear();
+        self.forward_visited.insert(from_index, true);
+        self.reverse_visited.clear();
+        self.reverse_visited.insert(to_index, true);
+    }
+}
+
 pub fn bidirectional_bfs<N, E>(
     graph: &Graph<N, E>,
+    scratch: &mut BidirBfsScratch,
     from_index: NodeIndex,
     to_index: NodeIndex,
     visitor: &mut impl BidirBfsVisitor,
 ) -> bool {
-    let mut forward_queue = VecDeque::from([from_index]);
-    let mut reverse_queue = VecDeque::from([to_index]);
-    let mut forward_visited = HashSet::default();
-    forward_visited.insert(from_index);
-    let mut reverse_visited = HashSet::default();
-    reverse_visited.insert(to_index);
+    scratch.reset(from_index, to_index);
+    let BidirBfsScratch {
+        forward_queue,
+        reverse_queue,
+        forward_visited,
+        reverse_visited,
+    } = scratch;
 
     while let (Some(forward_current), Some(reverse_current)) =
         (forward_queue.pop_front(), reverse_queue.pop_front())
     {
-        if forward_current == to_index || reverse_visited.contains(&forward_current) {
+        if forward_current == to_index || reverse_visited.get(forward_current) {
             visitor.visit_intersection_node(forward_current);
             return true;
         }
 
         for adjacent in graph.neighbors(forward_current) {
-            if !forward_visited.contains(&adjacent) {
+            if !forward_visited.get(adjacent) {
                 visitor.visit_forward_bfs_edge(forward_current, adjacent);
 
-                forward_visited.insert(adjacent);
+                forward_visited.insert(adjacent, true);
                 forward_queue.push_back(adjacent);
             }
         }
 
-        if reverse_current == from_index || forward_visited.contains(&reverse_current) {
+        if reverse_current == from_index || forward_visited.get(reverse_current) {
             visitor.visit_intersection_node(reverse_current);
             return true;
         }
 
         for adjacent in graph.neighbors_directed(reverse_current, petgraph::Direction::Incoming) {
-            if !reverse_visited.contains(&adjacent) {
+            if !reverse_visited.get(adjacent) {
                 visitor.visit_reverse_bfs_edge(adjacent, reverse_current);
 
-                reverse_visited.insert(adjacent);
+                reverse_visited.insert(adjacent, true);
                 reverse_queue.push_back(adjacent);
             }
         }
@@ -84,7 +170,7 @@ pub fn find_cycle<N>(
 ) -> Option<Vec<Vertex>> {
     let mut cycle_detector = CycleDetector::new(graph, node_mapper);
 
-    let mut colour_map = HashMap::default();
+    let mut colour_map = ColourMap::new();
 
     for node_index in graph.node_indices() {
         depth_first_search(graph, &mut colour_map, node_index, &mut cycle_detector);
@@ -108,7 +194,7 @@ pub enum Colour {
 
 pub fn depth_first_search<'a, N>(
     graph: &'a Graph<N, EdgeType>,
-    colour_map: &mut HashMap<NodeIndex, Colour>,
+    colour_map: &mut ColourMap,
     start_node_index: NodeIndex,
     visitor: &mut impl DfsVisitor<'a>,
 ) {
@@ -121,7 +207,7 @@ pub fn depth_first_search<'a, N>(
         if let Some(edge) = unprocessed_edges.next() {
             let target = edge.target();
 
-            match colour_map.get(&target).unwrap_or(&Colour::White) {
+            match colour_map.get(target) {
                 Colour::White => {
                     visitor.visit_tree_edge(edge);
 
@@ -227,3 +313,52 @@ impl<'a, N, F: FnMut(&N) -> String> DfsVisitor<'a> for CycleDetector<'a, N, F> {
         }
     }
 }
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    mod node_map {
+        use super::*;
+
+        #[test]
+        fn get_should_return_the_default_value_for_a_node_that_has_not_been_inserted() {
+            let mut map = ColourMap::new();
+            map.insert(NodeIndex::new(1), Colour::Grey);
+
+            assert_eq!(Colour::White, map.get(NodeIndex::new(0)));
+            assert_eq!(Colour::Grey, map.get(NodeIndex::new(1)));
+            assert_eq!(Colour::White, map.get(NodeIndex::new(2)));
+        }
+
+        #[test]
+        fn clear_should_discard_all_inserted_values() {
+            let mut map = ColourMap::new();
+            map.insert(NodeIndex::new(0), Colour::Grey);
+            map.insert(NodeIndex::new(1), Colour::Black);
+
+            map.clear();
+
+            assert_eq!(Colour::White, map.get(NodeIndex::new(0)));
+            assert_eq!(Colour::White, map.get(NodeIndex::new(1)));
+
+            map.insert(NodeIndex::new(1), Colour::Grey);
+
+            assert_eq!(Colour::Grey, map.get(NodeIndex::new(1)));
+        }
+
+        #[test]
+        fn clear_should_discard_old_values_when_the_generation_wraps_around() {
+            let mut map = ColourMap::new();
+            map.insert(NodeIndex::new(0), Colour::Black);
+            map.generation = u32::MAX;
+            map.insert(NodeIndex::new(1), Colour::Grey);
+
+            map.clear();
+
+            assert_eq!(1, map.generation);
+            assert_eq!(Colour::White, map.get(NodeIndex::new(0)));
+            assert_eq!(Colour::White, map.get(NodeIndex::new(1)));
+        }
+    }
+}
@@ -1,8 +1,8 @@
-use std::cmp::Reverse;
+use std::{cmp::Reverse, sync::OnceLock};
 
 use rustc_hash::FxHashMap as HashMap;
 
-use petgraph::{Graph, algo::bellman_ford, graph::NodeIndex};
+use petgraph::{Direction, Graph, algo::toposort, graph::NodeIndex, visit::EdgeRef};
 
 use crate::{
     EdgeType, LogLevel, Vertex,
@@ -17,7 +17,7 @@ use crate::{
 };
 
 use super::{
-    dfs::{DfsVisitor, depth_first_search},
+    dfs::{ColourMap, DfsVisitor, depth_first_search},
     error::GroupsPathError,
 };
 
@@ -113,92 +113,267 @@ fn sorted_clone(strings: &[String]) -> Vec<&str> {
     strings
 }
 
-pub fn find_path(
-    graph: &GroupsGraph,
-    from_group_name: &str,
-    to_group_name: &str,
-) -> Result<Vec<Vertex>, GroupsPathError> {
-    let float_graph: Graph<&Box<str>, f32> = graph.map(
-        |_, n| n,
-        |_, e| {
-            if *e == EdgeType::UserLoadAfter {
-                // A very small number so that user edges are practically always preferred.
-                -1_000_000.0
-            } else {
-                1.0
-            }
-        },
-    );
-
-    let from_vertex = find_node_by_weight(graph, from_group_name)?;
-    let to_vertex = find_node_by_weight(graph, to_group_name)?;
-
-    let paths =
-        bellman_ford(&float_graph, from_vertex).map_err(|_e| PathfindingError::NegativeCycle)?;
-
-    let mut path = vec![Vertex::new(graph[to_vertex].clone().into_string())];
-    let mut current = to_vertex;
-    while current != from_vertex {
-        let preceding_vertex = match paths.predecessors.get(current.index()) {
-            Some(Some(v)) => v,
-            Some(None) => {
-                logging::info!(
-                    "No path found from {} to {} while looking for path to {}",
-                    graph[from_vertex],
-                    graph[current],
-                    graph[to_vertex]
-                );
-                return Ok(Vec::new());
-            }
-            _ => {
-                return Err(PathfindingError::PrecedingNodeNotFound(
-                    graph[current].clone().into_string(),
-                )
+/// A groups graph together with an index of its nodes by name, and the
+/// preferred paths between its groups, which are calculated once for each
+/// group that a path starts from, when first needed.
+#[derive(Debug)]
+pub struct GroupsPathIndex {
+    graph: GroupsGraph,
+    node_indices: HashMap<Box<str>, NodeIndex>,
+    topological_order: Option<Box<[NodeIndex]>>,
+    predecessors: Box<[OnceLock<Box<[Option<NodeIndex>]>>]>,
+}
+
+/// The cost of a path, in terms of the number of user and non-user edges that
+/// it involves. Costs are ordered so that paths with more user edges are
+/// cheaper, and then paths with fewer other edges are cheaper.
+type PathCost = (Reverse<usize>, usize);
+
+impl GroupsPathIndex {
+    pub fn new(graph: GroupsGraph) -> Self {
+        let node_indices = graph
+            .node_indices()
+            .map(|i| (graph[i].clone(), i))
+            .collect();
+
+        let topological_order = toposort(&graph, None).ok().map(Vec::into_boxed_slice);
+
+        let predecessors = graph.node_indices().map(|_| OnceLock::new()).collect();
+
+        Self {
+            graph,
+            node_indices,
+            topological_order,
+            predecessors,
+        }
+    }
+
+    pub fn graph(&self) -> &GroupsGraph {
+        &self.graph
+    }
+
+    fn node_index(&self, group_name: &str) -> Result<NodeIndex, UndefinedGroupError> {
+        if let Some(n) = self.node_indices.get(group_name) {
+            Ok(*n)
+        } else {
+            logging::error!("Can't find group with name {group_name}");
+            Err(UndefinedGroupError::new(group_name.to_owned()))
+        }
+    }
+
+    /// Find the "shortest" path between the two given groups, i.e. the path
+    /// that involves the most user edges and then the fewest other edges. If
+    /// there is more than one such path, the path with the earliest-added
+    /// groups is preferred. If there is no path, the returned Vec is empty.
+    pub fn find_path(
+        &self,
+        from_group_name: &str,
+        to_group_name: &str,
+    ) -> Result<Vec<Vertex>, GroupsPathError> {
+        let graph = &self.graph;
+        let from_vertex = self.node_index(from_group_name)?;
+        let to_vertex = self.node_index(to_group_name)?;
+
+        let predecessors = self.predecessors(from_vertex)?;
+
+        let mut path = vec![Vertex::new(graph[to_vertex].clone().into_string())];
+        let mut current = to_vertex;
+        while current != from_vertex {
+            let preceding_vertex = match predecessors.get(current.index()) {
+                Some(Some(v)) => *v,
+                Some(None) => {
+                    logging::info!(
+                        "No path found from {} to {} while looking for path to {}",
+                        graph[from_vertex],
+                        graph[current],
+                        graph[to_vertex]
+                    );
+                    return Ok(Vec::new());
+                }
+                None => {
+                    return Err(PathfindingError::PrecedingNodeNotFound(
+                        graph[current].clone().into_string(),
+                    )
+                    .into());
+                }
+            };
+
+            let Some(edge) = graph.find_edge(preceding_vertex, current) else {
+                return Err(PathfindingError::EdgeNotFound {
+                    from_group: graph[preceding_vertex].clone().into_string(),
+                    to_group: graph[current].clone().into_string(),
+                }
                 .into());
-            }
+            };
+
+            let vertex = Vertex::new(graph[preceding_vertex].clone().into_string())
+                .with_out_edge_type(graph[edge]);
+            path.push(vertex);
+
+            current = preceding_vertex;
+        }
+
+        path.reverse();
+
+        Ok(path)
+    }
+
+    fn predecessors(
+        &self,
+        from_vertex: NodeIndex,
+    ) -> Result<&[Option<NodeIndex>], PathfindingError> {
+        let Some(topological_order) = &self.topological_order else {
+            // This should be impossible because the graph is checked for cycles
+            // when it's built.
+            return Err(PathfindingError::NegativeCycle);
         };
 
-        if *preceding_vertex == current {
-            logging::error!(
-                "Unreachable vertex {} encountered while looking for vertex {}",
-                graph[current],
-                graph[from_vertex]
-            );
-            return Ok(Vec::new());
+        let Some(cell) = self.predecessors.get(from_vertex.index()) else {
+            return Err(PathfindingError::PrecedingNodeNotFound(
+                self.graph[from_vertex].clone().into_string(),
+            ));
+        };
+
+        let predecessors =
+            cell.get_or_init(|| find_predecessors(&self.graph, topological_order, from_vertex));
+
+        Ok(predecessors)
+    }
+}
+
+/// Find the predecessor of each node on the preferred path to it from the
+/// given node. Because the graph is acyclic, this only needs to visit each
+/// node and edge once, in topological order.
+fn find_predecessors(
+    graph: &GroupsGraph,
+    topological_order: &[NodeIndex],
+    from_vertex: NodeIndex,
+) -> Box<[Option<NodeIndex>]> {
+    let mut costs: Vec<Option<PathCost>> = vec![None; graph.node_count()];
+    let mut predecessors = vec![None; graph.node_count()];
+
+    if let Some(cost) = costs.get_mut(from_vertex.index()) {
+        *cost = Some((Reverse(0), 0));
+    }
+
+    for node in topological_order {
+        if *node == from_vertex {
+            continue;
         }
 
-        let Some(edge) = graph.find_edge(*preceding_vertex, current) else {
-            return Err(PathfindingError::EdgeNotFound {
-                from_group: graph[*preceding_vertex].clone().into_string(),
-                to_group: graph[current].clone().into_string(),
+        let best = graph
+            .edges_directed(*node, Direction::Incoming)
+            .filter_map(|edge| {
+                let source = edge.source();
+                let (Reverse(user_edges), other_edges) =
+                    costs.get(source.index()).copied().flatten()?;
+
+                let cost = if *edge.weight() == EdgeType::UserLoadAfter {
+                    (Reverse(user_edges + 1), other_edges)
+                } else {
+                    (Reverse(user_edges), other_edges + 1)
+                };
+
+                Some((cost, source))
+            })
+            .min();
+
+        if let Some((cost, source)) = best {
+            if let Some(c) = costs.get_mut(node.index()) {
+                *c = Some(cost);
+            }
+            if let Some(p) = predecessors.get_mut(node.index()) {
+                *p = Some(source);
             }
-            .into());
+        }
+    }
+
+    predecessors.into_boxed_slice()
+}
+
+/// The transitive closure of a groups graph, i.e. the groups that are
+/// reachable from each group (including itself), stored as a bitset for each
+/// group.
+#[derive(Debug)]
+pub struct GroupsClosure {
+    node_count: usize,
+    words_per_node: usize,
+    bits: Box<[u64]>,
+}
+
+impl GroupsClosure {
+    pub fn new(graph: &GroupsGraph) -> Self {
+        let node_count = graph.node_count();
+        let words_per_node = node_count.div_ceil(64);
+        let mut closure = Self {
+            node_count,
+            words_per_node,
+            bits: vec![0; node_count * words_per_node].into_boxed_slice(),
+        };
+
+        let Ok(sorted_nodes) = toposort(graph, None) else {
+            // This should be impossible because groups graphs are checked for
+            // cycles when they're built, but if it happens treat every group
+            // as reachable from every other group.
+            logging::error!("Unexpectedly found a cycle in the groups graph");
+            closure.bits.fill(u64::MAX);
+            return closure;
         };
 
-        let vertex = Vertex::new(graph[*preceding_vertex].clone().into_string())
-            .with_out_edge_type(graph[edge]);
-        path.push(vertex);
+        // Visit the nodes in reverse topological order so that the closure of
+        // each node's successors is complete before it's merged into the
+        // closure of that node.
+        for node in sorted_nodes.into_iter().rev() {
+            closure.insert(node, node);
 
-        current = *preceding_vertex;
+            for successor in graph.neighbors(node) {
+                closure.merge(node, successor);
+            }
+        }
+
+        closure
     }
 
-    path.reverse();
+    pub fn contains(&self, from: NodeIndex, to: NodeIndex) -> bool {
+        let (word_index, mask) = self.bit_position(from, to);
 
-    Ok(path)
-}
+        self.bits
+            .get(word_index)
+            .is_some_and(|word| word & mask != 0)
+    }
 
-fn find_node_by_weight(
-    graph: &Graph<Box<str>, EdgeType>,
-    weight: &str,
-) -> Result<NodeIndex, UndefinedGroupError> {
-    if let Some(n) = graph
-        .node_indices()
-        .find(|i| graph.node_weight(*i).is_some_and(|w| w.as_ref() == weight))
-    {
-        Ok(n)
-    } else {
-        logging::error!("Can't find group with name {weight}");
-        Err(UndefinedGroupError::new(weight.to_owned()))
+    pub fn reachable_nodes(&self, from: NodeIndex) -> impl Iterator<Item = NodeIndex> {
+        (0..self.node_count)
+            .map(NodeIndex::new)
+            .filter(move |to| self.contains(from, *to))
+    }
+
+    fn insert(&mut self, from: NodeIndex, to: NodeIndex) {
+        let (word_index, mask) = self.bit_position(from, to);
+
+        if let Some(word) = self.bits.get_mut(word_index) {
+            *word |= mask;
+        }
+    }
+
+    fn merge(&mut self, into: NodeIndex, from: NodeIndex) {
+        let into_start = into.index() * self.words_per_node;
+        let from_start = from.index() * self.words_per_node;
+
+        for i in 0..self.words_per_node {
+            let from_word = self.bits.get(from_start + i).copied().unwrap_or_default();
+
+            if let Some(word) = self.bits.get_mut(into_start + i) {
+                *word |= from_word;
+            }
+        }
+    }
+
+    fn bit_position(&self, from: NodeIndex, to: NodeIndex) -> (usize, u64) {
+        let word_index = from.index() * self.words_per_node + (to.index() >> 6);
+        let mask = 1 << (to.index() & 63);
+
+        (word_index, mask)
     }
 }
 
@@ -206,13 +381,15 @@ fn find_node_by_weight(
 /// decreasing path length, but otherwise preserving the existing
 /// (lexicographical) ordering.
 pub fn sorted_group_nodes(graph: &GroupsGraph) -> Vec<NodeIndex> {
+    let mut colour_map = ColourMap::new();
     let mut nodes: Vec<(NodeIndex, bool, usize)> = graph
         .node_indices()
         .map(|n| {
             if is_root_node(graph, n) {
                 let mut visitor = GroupsPathLengthVisitor::new();
 
-                depth_first_search(graph, &mut HashMap::default(), n, &mut visitor);
+                colour_map.clear();
+                depth_first_search(graph, &mut colour_map, n, &mut visitor);
 
                 (n, true, visitor.max_path_length())
             } else {
@@ -363,6 +540,53 @@ mod tests {
         }
     }
 
+    mod groups_closure {
+        use super::*;
+
+        #[test]
+        fn should_contain_each_group_and_the_groups_that_load_after_it() {
+            let masterlist = &[
+                Group::new("a".into()),
+                Group::new("b".into()).with_after_groups(vec!["a".into()]),
+                Group::new("c".into()).with_after_groups(vec!["b".into()]),
+                Group::new("d".into()),
+            ];
+            let graph = build_groups_graph(masterlist, &[]).unwrap();
+            let closure = GroupsClosure::new(&graph);
+
+            let reachable_names = |name: &str| {
+                let node = graph.node_indices().find(|n| graph[*n].as_ref() == name);
+                closure
+                    .reachable_nodes(node.unwrap())
+                    .map(|n| graph[n].as_ref())
+                    .collect::<Vec<_>>()
+            };
+
+            assert_eq!(vec!["a", "b", "c"], reachable_names("a"));
+            assert_eq!(vec!["b", "c"], reachable_names("b"));
+            assert_eq!(vec!["c"], reachable_names("c"));
+            assert_eq!(vec!["d"], reachable_names("d"));
+        }
+
+        #[test]
+        fn should_support_more_than_64_groups() {
+            let mut masterlist = vec![Group::new("g000".into())];
+            for i in 1..100 {
+                let after = format!("g{:03}", i - 1);
+                masterlist.push(Group::new(format!("g{i:03}")).with_after_groups(vec![after]));
+            }
+            let graph = build_groups_graph(&masterlist, &[]).unwrap();
+            let closure = GroupsClosure::new(&graph);
+
+            let first = graph.node_indices().find(|n| graph[*n].as_ref() == "g000");
+            let last = graph.node_indices().find(|n| graph[*n].as_ref() == "g099");
+
+            assert!(closure.contains(first.unwrap(), last.unwrap()));
+            assert!(!closure.contains(last.unwrap(), first.unwrap()));
+            assert_eq!(100, closure.reachable_nodes(first.unwrap()).count());
+        }
+    }
+
     mod find_path {
         use super::*;
 
@@ -372,9 +596,9 @@ mod tests {
                 Group::new("a".into()),
                 Group::new("b".into()).with_after_groups(vec!["a".into()]),
             ];
-            let graph = build_groups_graph(masterlist, &[]).unwrap();
+            let index = GroupsPathIndex::new(build_groups_graph(masterlist, &[]).unwrap());
 
-            assert!(find_path(&graph, "c", "a").is_err());
+            assert!(index.find_path("c", "a").is_err());
         }
 
         #[test]
@@ -383,17 +607,17 @@ mod tests {
                 Group::new("a".into()),
                 Group::new("b".into()).with_after_groups(vec!["a".into()]),
             ];
-            let graph = build_groups_graph(masterlist, &[]).unwrap();
+            let index = GroupsPathIndex::new(build_groups_graph(masterlist, &[]).unwrap());
 
-            assert!(find_path(&graph, "a", "c").is_err());
+            assert!(index.find_path("a", "c").is_err());
         }
 
         #[test]
         fn should_return_an_empty_vec_if_there_is_no_path() {
             let masterlist = &[Group::new("a".into()), Group::new("b".into())];
-            let graph = build_groups_graph(masterlist, &[]).unwrap();
+            let index = GroupsPathIndex::new(build_groups_graph(masterlist, &[]).unwrap());
 
-            let path = find_path(&graph, "a", "b").unwrap();
+            let path = index.find_path("a", "b").unwrap();
 
             assert!(path.is_empty());
         }
@@ -407,9 +631,9 @@ mod tests {
                 Group::new("d".into()).with_after_groups(vec!["c".into()]),
                 Group::new("e".into()).with_after_groups(vec!["b".into(), "d".into()]),
             ];
-            let graph = build_groups_graph(masterlist, &[]).unwrap();
+            let index = GroupsPathIndex::new(build_groups_graph(masterlist, &[]).unwrap());
 
-            let path = find_path(&graph, "a", "e").unwrap();
+            let path = index.find_path("a", "e").unwrap();
 
             assert_eq!(
                 &[
@@ -433,9 +657,9 @@ mod tests {
                 Group::new("d".into()).with_after_groups(vec!["c".into()]),
                 Group::new("e".into()).with_after_groups(vec!["d".into()]),
             ];
-            let graph = build_groups_graph(masterlist, userlist).unwrap();
+            let index = GroupsPathIndex::new(build_groups_graph(masterlist, userlist).unwrap());
 
-            let path = find_path(&graph, "a", "e").unwrap();
+            let path = index.find_path("a", "e").unwrap();
 
             assert_eq!(
                 &[
@@ -468,9 +692,9 @@ mod tests {
             ];
 
             for masterlist in masterlists {
-                let graph = build_groups_graph(*masterlist, &[]).unwrap();
+                let index = GroupsPathIndex::new(build_groups_graph(*masterlist, &[]).unwrap());
 
-                let path = find_path(&graph, "a", "e").unwrap();
+                let path = index.find_path("a", "e").unwrap();
                 assert_eq!(
                     &[
                         Vertex::new("a".into()).with_out_edge_type(EdgeType::MasterlistLoadAfter),
@@ -2,13 +2,22 @@ mod dfs;
 pub mod error;
 pub mod groups;
 pub mod plugins;
+pub mod result_cache;
 mod validate;
 pub mod vertex;
 
 #[cfg(test)]
 mod test {
+    use std::hash::{DefaultHasher, Hash, Hasher};
+
     use super::plugins::SortingPlugin;
-    use crate::error::PluginDataError;
+    use crate::{error::PluginDataError, game::FileStamp};
+
+    fn hash(value: &str) -> u64 {
+        let mut hasher = DefaultHasher::new();
+        value.hash(&mut hasher);
+        hasher.finish()
+    }
 
     #[derive(Default)]
     pub struct TestPlugin {
@@ -20,6 +29,7 @@ mod test {
         pub(super) asset_count: usize,
         overlapping_record_plugins: Vec<String>,
         overlapping_asset_plugins: Vec<String>,
+        pub(super) has_namespaced_record_ids: bool,
     }
 
     impl TestPlugin {
@@ -56,6 +66,10 @@ mod test {
             self.is_blueprint_plugin
         }
 
+        fn file_stamp(&self) -> Option<FileStamp> {
+            None
+        }
+
         fn masters(&self) -> Result<Vec<String>, PluginDataError> {
             Ok(self.masters.clone())
         }
@@ -72,8 +86,20 @@ mod test {
             Ok(self.overlapping_record_plugins.contains(&other.name))
         }
 
-        fn do_assets_overlap(&self, other: &Self) -> bool {
-            self.overlapping_asset_plugins.contains(&other.name)
+        fn has_namespaced_record_ids(&self) -> bool {
+            self.has_namespaced_record_ids
+        }
+
+        fn assets(&self) -> impl Iterator<Item = (u64, u64)> {
+            // Each plugin loads an asset that's unique to it, and also loads the
+            // unique assets of the plugins that it's been told overlap with it,
+            // so that two plugins share an asset if either was given the other
+            // as an overlapping plugin. This isn't one-to-one: two plugins
+            // that were both given the same third plugin also share an asset,
+            // that plugin's unique asset, so overlap with each other too.
+            std::iter::once(self.name.as_str())
+                .chain(self.overlapping_asset_plugins.iter().map(String::as_str))
+                .map(|name| (0, hash(name)))
         }
     }
 }
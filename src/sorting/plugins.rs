@@ -1,4 +1,4 @@
-use std::rc::Rc;
+use std::{cmp::Reverse, collections::BinaryHeap, rc::Rc, time::UNIX_EPOCH};
 
 use petgraph::{
     Graph,
@@ -6,21 +6,27 @@ use petgraph::{
     visit::EdgeRef,
 };
 use rustc_hash::{FxHashMap as HashMap, FxHashSet as HashSet};
+use unicase::UniCase;
 
 use crate::{
     EdgeType, LogLevel, Plugin,
+    game::FileStamp,
     logging::{self, is_log_enabled},
     metadata::{File, Group, PluginMetadata},
     plugin::error::PluginDataError,
     sorting::{
         error::{CyclicInteractionError, PathfindingError, SortingError, UndefinedGroupError},
         groups::{get_default_group_node, sorted_group_nodes},
+        result_cache::StableHasher,
     },
 };
 
 use super::{
-    dfs::{BidirBfsVisitor, DfsVisitor, bidirectional_bfs, depth_first_search, find_cycle},
-    groups::GroupsGraph,
+    dfs::{
+        BidirBfsScratch, BidirBfsVisitor, ColourMap, DfsVisitor, bidirectional_bfs,
+        depth_first_search, find_cycle,
+    },
+    groups::{GroupsClosure, GroupsGraph},
     validate::{validate_plugin_groups, validate_specific_and_hardcoded_edges},
 };
 
@@ -75,7 +81,7 @@ impl<'a, T: SortingPlugin> PluginSortingData<'a, T> {
         })
     }
 
-    pub(super) fn name(&self) -> &str {
+    pub(super) fn name(&self) -> &'a str {
         self.plugin.name()
     }
 
@@ -95,8 +101,68 @@ impl<'a, T: SortingPlugin> PluginSortingData<'a, T> {
         self.plugin.do_records_overlap(other.plugin)
     }
 
-    fn do_assets_overlap(&self, other: &Self) -> bool {
-        self.plugin.do_assets_overlap(other.plugin)
+    /// Get the names of the plugins that this plugin's records may have come
+    /// from, or `None` if that can't be known. A plugin's FormIDs are
+    /// namespaced by either one of its masters or the plugin itself, and a
+    /// plugin that has no override records only has records in its own
+    /// namespace.
+    fn record_origins(&self) -> Result<Option<Vec<String>>, PluginDataError> {
+        if !self.plugin.has_namespaced_record_ids() {
+            return Ok(None);
+        }
+
+        let mut origins = vec![self.name().to_owned()];
+        if self.override_record_count > 0 {
+            origins.extend(self.masters()?);
+        }
+
+        Ok(Some(origins))
+    }
+
+    fn assets(&self) -> impl Iterator<Item = (u64, u64)> {
+        self.plugin.assets()
+    }
+
+    /// Hash all the data about the plugin that can affect the result of
+    /// sorting it.
+    fn hash_sorting_inputs(&self, hasher: &mut StableHasher) -> Result<(), PluginDataError> {
+        hasher.write_str(self.name());
+
+        // The file's modification time and size stand in for its contents,
+        // as calculating its CRC would mean reading the whole file again.
+        let file_stamp = self.plugin.file_stamp().and_then(|(modified, size)| {
+            let modified = modified.duration_since(UNIX_EPOCH).ok()?;
+            Some((modified, size))
+        });
+        match file_stamp {
+            Some((modified, size)) => {
+                hasher.write_bool(true);
+                hasher.write_u64(modified.as_secs());
+                hasher.write_u64(u64::from(modified.subsec_nanos()));
+                hasher.write_u64(size);
+            }
+            None => hasher.write_bool(false),
+        }
+        hasher.write_bool(self.is_master);
+        hasher.write_bool(self.plugin.is_blueprint_plugin());
+        hasher.write_bool(self.plugin.has_namespaced_record_ids());
+        hasher.write_strs(&self.masters()?);
+        hasher.write_usize(self.override_record_count);
+        hasher.write_usize(self.asset_count());
+        for (folder_hash, file_hash) in self.assets() {
+            hasher.write_u64(folder_hash);
+            hasher.write_u64(file_hash);
+        }
+
+        hasher.write_usize(self.load_order_index);
+        hasher.write_str(&self.group);
+        hasher.write_bool(self.group_is_user_metadata);
+        hasher.write_strs(&self.masterlist_load_after);
+        hasher.write_strs(&self.user_load_after);
+        hasher.write_strs(&self.masterlist_req);
+        hasher.write_strs(&self.user_req);
+
+        Ok(())
     }
 }
 
@@ -104,11 +170,17 @@ pub trait SortingPlugin {
     fn name(&self) -> &str;
     fn is_master(&self) -> bool;
     fn is_blueprint_plugin(&self) -> bool;
+    /// Get the modification time and size of the plugin file when it was
+    /// loaded, if known.
+    fn file_stamp(&self) -> Option<FileStamp>;
     fn masters(&self) -> Result<Vec<String>, PluginDataError>;
     fn override_record_count(&self) -> Result<usize, PluginDataError>;
     fn asset_count(&self) -> usize;
     fn do_records_overlap(&self, other: &Self) -> Result<bool, PluginDataError>;
-    fn do_assets_overlap(&self, other: &Self) -> bool;
+    fn has_namespaced_record_ids(&self) -> bool;
+    /// Get the (folder hash, file hash) pairs of the assets that the plugin
+    /// loads from Bethesda archives.
+    fn assets(&self) -> impl Iterator<Item = (u64, u64)>;
 }
 
 impl SortingPlugin for Plugin {
@@ -123,6 +195,10 @@ impl SortingPlugin for Plugin {
         self.is_blueprint_plugin()
     }
 
+    fn file_stamp(&self) -> Option<FileStamp> {
+        self.file_stamp()
+    }
+
     fn masters(&self) -> Result<Vec<String>, PluginDataError> {
         self.masters()
     }
@@ -136,8 +212,11 @@ impl SortingPlugin for Plugin {
     fn do_records_overlap(&self, other: &Self) -> Result<bool, PluginDataError> {
         self.do_records_overlap(other)
     }
-    fn do_assets_overlap(&self, other: &Self) -> bool {
-        self.do_assets_overlap(other)
+    fn has_namespaced_record_ids(&self) -> bool {
+        self.has_namespaced_record_ids()
+    }
+    fn assets(&self) -> impl Iterator<Item = (u64, u64)> {
+        self.assets()
     }
 }
 
@@ -145,6 +224,62 @@ fn to_filenames(files: &[File]) -> Box<[String]> {
     files.iter().map(|f| f.name().as_str().to_owned()).collect()
 }
 
+/// The ways in which sorting can break ties between plugins that have no
+/// other reason to load in a particular order relative to one another.
+#[derive(Clone, Copy, Debug, Default, Eq, PartialEq, Hash)]
+#[non_exhaustive]
+pub enum TieBreakStrategy {
+    /// Add edges between consecutive plugins in the current load order,
+    /// walking back through the new load order to reposition plugins whenever
+    /// an edge would cause a cycle.
+    #[default]
+    LoadOrderPaths,
+    /// Calculate the sorted load order directly using a topological sort that
+    /// always picks the plugin that is earliest in the current load order out
+    /// of the plugins that are free to load next. This is faster, but can
+    /// produce a different load order when plugins need to be moved.
+    LoadOrderPriority,
+}
+
+/// Records whether pairs of plugins have overlapping records, so that the
+/// relatively slow overlap checks don't need to be repeated when the same
+/// plugins are sorted again. Pairs are identified by their plugins' names, so
+/// a plugin's entries must be removed if it is reloaded.
+#[derive(Debug, Default)]
+pub struct RecordOverlapCache {
+    overlaps: HashMap<(UniCase<String>, UniCase<String>), bool>,
+}
+
+impl RecordOverlapCache {
+    pub fn remove_plugin(&mut self, plugin_name: &str) {
+        let plugin_name = UniCase::new(plugin_name);
+
+        self.overlaps
+            .retain(|(a, b), _| *a != plugin_name && *b != plugin_name);
+    }
+
+    fn get_or_try_insert_with<E>(
+        &mut self,
+        plugin_name: &str,
+        other_plugin_name: &str,
+        f: impl FnOnce() -> Result<bool, E>,
+    ) -> Result<bool, E> {
+        let key = (
+            UniCase::new(plugin_name.to_owned()),
+            UniCase::new(other_plugin_name.to_owned()),
+        );
+
+        if let Some(overlap) = self.overlaps.get(&key) {
+            return Ok(*overlap);
+        }
+
+        let overlap = f()?;
+        self.overlaps.insert(key, overlap);
+
+        Ok(overlap)
+    }
+}
+
 type InnerPluginsGraph<'a, T> = Graph<Rc<PluginSortingData<'a, T>>, EdgeType>;
 
 #[derive(Debug)]
@@ -152,6 +287,20 @@ struct PluginsGraph<'a, T: SortingPlugin> {
     // Put the sorting data in Rc so that it can be held onto while mutating the graph.
     inner: InnerPluginsGraph<'a, T>,
     paths_cache: HashMap<NodeIndex, HashSet<NodeIndex>>,
+    // The targets of each node's outgoing edges, sorted by index. petgraph
+    // stores edges as linked lists, so this is used to check for edges
+    // between two nodes in O(log n) time instead of O(n) time.
+    sorted_successors: Vec<Vec<NodeIndex>>,
+    // Plugin names are case-insensitive, and plugins' masters and metadata
+    // can refer to them using any case, so this maps each node's case-folded
+    // name to its index to avoid scanning all nodes for each reference. The
+    // names are borrowed from the plugins, so lookups don't allocate.
+    node_indices_by_name: HashMap<UniCase<&'a str>, NodeIndex>,
+    // Reused by every bidirectional search for a path between two nodes.
+    bfs_scratch: BidirBfsScratch,
+    // Only set while adding overlap edges for a sort that keeps its overlap
+    // results, otherwise each pair of plugins is checked directly.
+    record_overlaps: Option<RecordOverlapCache>,
 }
 
 impl<'a, T: SortingPlugin> PluginsGraph<'a, T> {
@@ -160,7 +309,16 @@ impl<'a, T: SortingPlugin> PluginsGraph<'a, T> {
     }
 
     fn add_node(&mut self, plugin: PluginSortingData<'a, T>) -> NodeIndex {
-        self.inner.add_node(Rc::new(plugin))
+        let name = UniCase::new(plugin.name());
+        let node_index = self.inner.add_node(Rc::new(plugin));
+
+        self.sorted_successors.push(Vec::new());
+
+        // Keep the first node if there are duplicate names, like a linear
+        // search would.
+        self.node_indices_by_name.entry(name).or_insert(node_index);
+
+        node_index
     }
 
     fn add_edge(&mut self, from: NodeIndex, to: NodeIndex, edge_type: EdgeType) {
@@ -177,9 +335,22 @@ impl<'a, T: SortingPlugin> PluginsGraph<'a, T> {
 
         self.inner.add_edge(from, to, edge_type);
 
+        // An edge is only added if there's no known path between the two
+        // nodes, so there's no need to check for a duplicate.
+        if let Some(successors) = self.sorted_successors.get_mut(from.index()) {
+            let position = successors.partition_point(|n| *n < to);
+            successors.insert(position, to);
+        }
+
         self.cache_path(from, to);
     }
 
+    fn contains_edge(&self, from: NodeIndex, to: NodeIndex) -> bool {
+        self.sorted_successors
+            .get(from.index())
+            .is_some_and(|s| s.binary_search(&to).is_ok())
+    }
+
     fn node_indices(&self) -> petgraph::graph::NodeIndices {
         self.inner.node_indices()
     }
@@ -301,9 +472,26 @@ impl<'a, T: SortingPlugin> PluginsGraph<'a, T> {
         // Get the default group's vertex because it's needed for the DFSes.
         let default_group_node = get_default_group_node(groups_graph)?;
 
+        // A DFS from a group can only add edges between plugins in two different
+        // groups that are reachable from that group, so use the groups graph's
+        // transitive closure to skip DFSes that can't add any edges. Skipping
+        // them doesn't affect the DFSes that are run, because any group that a
+        // skipped DFS would have marked as finished can't reach another group
+        // that contains plugins.
+        let closure = GroupsClosure::new(groups_graph);
+        let can_add_edges = |group_node: NodeIndex| {
+            closure
+                .reachable_nodes(group_node)
+                .filter(|n| plugins_in_groups.contains_key(&groups_graph[*n]))
+                .nth(1)
+                .is_some()
+        };
+
         // Keep a record of which vertices have already been fully explored to avoid
         // adding edges from their plugins more than once.
         let mut finished_nodes = HashSet::default();
+        // The colour map is reused between DFSes to avoid reallocating it.
+        let mut colour_map = ColourMap::new();
         // Now loop over the vertices in the groups graph.
         // The vertex sort order prioritises resolving potential cycles in
         // favour of earlier-loading groups. It does not guarantee that the
@@ -311,6 +499,10 @@ impl<'a, T: SortingPlugin> PluginsGraph<'a, T> {
         // more than one path and the vertex sort order here does not influence
         // which path the DFS takes.
         for group_node in sorted_group_nodes(groups_graph) {
+            if !can_add_edges(group_node) {
+                continue;
+            }
+
             // Run a DFS from each vertex in the group graph, adding edges except from
             // plugins in the default group. This could be run only on the root
             // vertices, except that the DFS only visits each vertex once, so a branch
@@ -325,12 +517,12 @@ impl<'a, T: SortingPlugin> PluginsGraph<'a, T> {
                 Some(default_group_node),
             );
 
-            depth_first_search(
-                groups_graph,
-                &mut HashMap::default(),
-                group_node,
-                &mut visitor,
-            );
+            colour_map.clear();
+            depth_first_search(groups_graph, &mut colour_map, group_node, &mut visitor);
+        }
+
+        if !can_add_edges(default_group_node) {
+            return Ok(());
         }
 
         // Now do one last DFS starting from the default group and not ignoring its
@@ -343,9 +535,10 @@ impl<'a, T: SortingPlugin> PluginsGraph<'a, T> {
             None,
         );
 
+        colour_map.clear();
         depth_first_search(
             groups_graph,
-            &mut HashMap::default(),
+            &mut colour_map,
             default_group_node,
             &mut visitor,
         );
@@ -356,8 +549,23 @@ impl<'a, T: SortingPlugin> PluginsGraph<'a, T> {
     fn add_overlap_edges(&mut self) -> Result<(), SortingError> {
         logging::trace!("Adding edges for overlapping plugins...");
 
-        let mut node_index_iter = self.node_indices();
-        while let Some(node_index) = node_index_iter.next() {
+        // Only visit the pairs of plugins that may overlap, instead of every
+        // pair of plugins. The pairs are visited in the same order as if every
+        // pair was iterated over, to give the same result.
+        let record_overlap_candidates = self.find_record_overlap_candidates()?;
+        let asset_overlaps = self.find_asset_overlaps();
+
+        let mut candidate_pairs: Vec<_> = record_overlap_candidates
+            .union(&asset_overlaps)
+            .copied()
+            .collect();
+        candidate_pairs.sort_unstable();
+
+        for pairs in candidate_pairs.chunk_by(|a, b| a.0 == b.0) {
+            let Some((node_index, _)) = pairs.first().copied() else {
+                continue;
+            };
+
             let plugin = Rc::clone(&self[node_index]);
             let plugin_asset_count = plugin.asset_count();
 
@@ -372,13 +580,13 @@ impl<'a, T: SortingPlugin> PluginsGraph<'a, T> {
             // This loop should have no effect now that master-flagged and
             // non-master-flagged plugins are sorted separately, but is kept
             // as a safety net.
-            for other_node_index in node_index_iter.clone() {
-                let other_plugin = &self[other_node_index];
+            for (_, other_node_index) in pairs.iter().copied() {
+                let other_plugin = Rc::clone(&self[other_node_index]);
 
                 // Don't add an edge between these two plugins if one already
                 // exists (only check direct edges and not paths for efficiency).
-                if self.inner.contains_edge(node_index, other_node_index)
-                    || self.inner.contains_edge(other_node_index, node_index)
+                if self.contains_edge(node_index, other_node_index)
+                    || self.contains_edge(other_node_index, node_index)
                 {
                     continue;
                 }
@@ -401,14 +609,15 @@ impl<'a, T: SortingPlugin> PluginsGraph<'a, T> {
                 let edge_type;
 
                 if plugin.override_record_count == other_plugin.override_record_count
-                    || !plugin.do_records_overlap(other_plugin)?
+                    || !record_overlap_candidates.contains(&(node_index, other_node_index))
+                    || !self.do_records_overlap(&plugin, &other_plugin)?
                 {
                     // Records don't overlap, or override the same number of records,
                     // check assets.
                     // No records overlap, check assets.
                     let other_plugin_asset_count = other_plugin.asset_count();
                     if plugin_asset_count == other_plugin_asset_count
-                        || !plugin.do_assets_overlap(other_plugin)
+                        || !asset_overlaps.contains(&(node_index, other_node_index))
                     {
                         // Assets don't overlap or both plugins load the same number of
                         // assets, don't add an edge.
@@ -449,6 +658,132 @@ impl<'a, T: SortingPlugin> PluginsGraph<'a, T> {
         Ok(())
     }
 
+    fn do_records_overlap(
+        &mut self,
+        plugin: &PluginSortingData<'a, T>,
+        other_plugin: &PluginSortingData<'a, T>,
+    ) -> Result<bool, PluginDataError> {
+        match &mut self.record_overlaps {
+            Some(record_overlaps) => {
+                record_overlaps.get_or_try_insert_with(plugin.name(), other_plugin.name(), || {
+                    plugin.do_records_overlap(other_plugin)
+                })
+            }
+            None => plugin.do_records_overlap(other_plugin),
+        }
+    }
+
+    /// Find the pairs of plugins that may override the same records.
+    ///
+    /// esplugin does not expose the record IDs in each plugin, so this uses the
+    /// plugins that records could have originated from instead. Two plugins
+    /// can only override the same record if they share at least one of those
+    /// origins, so this builds an inverted index from origins to plugins and
+    /// pairs up the plugins for each origin. Plugins with record IDs that are
+    /// not namespaced are paired with every other plugin. The lower node index
+    /// is first in each pair.
+    fn find_record_overlap_candidates(
+        &self,
+    ) -> Result<HashSet<(NodeIndex, NodeIndex)>, PluginDataError> {
+        let mut origin_plugins = Vec::new();
+        let mut unknown_origin_nodes = Vec::new();
+        for node_index in self.node_indices() {
+            match self[node_index].record_origins()? {
+                Some(origins) => origin_plugins.extend(
+                    origins
+                        .into_iter()
+                        .map(|origin| (UniCase::new(origin), node_index)),
+                ),
+                None => unknown_origin_nodes.push(node_index),
+            }
+        }
+
+        // Sorting groups together all the plugins that have records in each
+        // namespace, in ascending order of node index.
+        origin_plugins.sort_unstable();
+
+        let mut candidates = HashSet::default();
+        for chunk in origin_plugins.chunk_by(|a, b| a.0 == b.0) {
+            let mut plugin_set: Vec<_> = chunk.iter().map(|(_, node_index)| *node_index).collect();
+            // A plugin could list the same master more than once.
+            plugin_set.dedup();
+
+            for (i, node_index) in plugin_set.iter().enumerate() {
+                for other_node_index in plugin_set.iter().skip(i + 1) {
+                    candidates.insert((*node_index, *other_node_index));
+                }
+            }
+        }
+
+        for node_index in unknown_origin_nodes {
+            for other_node_index in self.node_indices() {
+                if other_node_index != node_index {
+                    candidates.insert((
+                        node_index.min(other_node_index),
+                        node_index.max(other_node_index),
+                    ));
+                }
+            }
+        }
+
+        logging::debug!(
+            "Found {} pairs of plugins that may override the same records",
+            candidates.len()
+        );
+
+        Ok(candidates)
+    }
+
+    /// Find the pairs of plugins that load at least one asset with the same
+    /// path. Instead of comparing the assets of every pair of plugins, this
+    /// builds an inverted index from assets to the plugins that load them, so
+    /// that only plugins that actually share assets get paired. The lower node
+    /// index is first in each pair.
+    fn find_asset_overlaps(&self) -> HashSet<(NodeIndex, NodeIndex)> {
+        let mut asset_plugins: Vec<_> = self
+            .node_indices()
+            .flat_map(|node_index| {
+                self[node_index]
+                    .assets()
+                    .map(move |asset| (asset, node_index))
+            })
+            .collect();
+
+        // Sorting groups together all the plugins that load each asset, in
+        // ascending order of node index.
+        asset_plugins.sort_unstable();
+
+        let mut overlaps = HashSet::default();
+        let mut visited_plugin_sets = HashSet::default();
+        for chunk in asset_plugins.chunk_by(|a, b| a.0 == b.0) {
+            if chunk.len() < 2 {
+                continue;
+            }
+
+            // Archives usually contain many assets that are loaded by the same
+            // set of plugins, so only pair up the plugins in each set once.
+            let plugin_set: Vec<_> = chunk.iter().map(|(_, node_index)| *node_index).collect();
+            if visited_plugin_sets.contains(&plugin_set) {
+                continue;
+            }
+
+            for (i, node_index) in plugin_set.iter().enumerate() {
+                for other_node_index in plugin_set.iter().skip(i + 1) {
+                    overlaps.insert((*node_index, *other_node_index));
+                }
+            }
+
+            visited_plugin_sets.insert(plugin_set);
+        }
+
+        logging::debug!(
+            "Found {} pairs of plugins that load the same assets",
+            overlaps.len()
+        );
+
+        overlaps
+    }
+
     fn add_tie_break_edges(&mut self) -> Result<(), PathfindingError> {
         logging::trace!("Adding edges to break ties between plugins...");
 
@@ -692,6 +1027,75 @@ impl<'a, T: SortingPlugin> PluginsGraph<'a, T> {
             .map_err(|e| SortingError::CycleInvolving(self[e.node_id()].name().to_owned()))
     }
 
+    /// Sort the graph's nodes using Kahn's algorithm, picking the node with
+    /// the lowest load order index whenever more than one node could come
+    /// next.
+    ///
+    /// This gives a valid sorted load order because a node is only picked once
+    /// all the nodes with edges going to it have been picked, so every edge
+    /// goes from an earlier node to a later node. If the graph has a cycle,
+    /// the nodes in it are never picked, so that is detected by not all nodes
+    /// being picked.
+    ///
+    /// The result is unique for a given graph and current load order, because
+    /// each pick is the minimum of a totally-ordered set of (load order index,
+    /// node index) pairs. There's therefore no need to add tie-break edges to
+    /// make the path through the graph Hamiltonian.
+    ///
+    /// If the current load order is already a valid sorted load order, it is
+    /// returned unchanged: by induction, when the first k plugins in the
+    /// current load order have been picked, the next plugin in the current
+    /// load order can only have edges coming from those k plugins, so it is
+    /// free to load next, and it has the lowest load order index of all the
+    /// plugins that have not been picked, so it is picked. More generally, the
+    /// result is the sorted load order that comes first when comparing load
+    /// orders by the current load order indices of their plugins, position by
+    /// position.
+    fn priority_topological_sort(&self) -> Result<Vec<NodeIndex>, SortingError> {
+        logging::trace!("Sorting plugins by their current load order positions...");
+
+        let mut in_degrees = vec![0_usize; self.inner.node_count()];
+        for edge in self.inner.edge_references() {
+            if let Some(in_degree) = in_degrees.get_mut(edge.target().index()) {
+                *in_degree += 1;
+            }
+        }
+
+        let mut available_nodes: BinaryHeap<_> = self
+            .node_indices()
+            .filter(|i| in_degrees.get(i.index()) == Some(&0))
+            .map(|i| Reverse((self[i].load_order_index, i)))
+            .collect();
+
+        let mut sorted_nodes = Vec::with_capacity(self.inner.node_count());
+        while let Some(Reverse((_, node_index))) = available_nodes.pop() {
+            sorted_nodes.push(node_index);
+
+            for edge in self.inner.edges(node_index) {
+                let target = edge.target();
+                if let Some(in_degree) = in_degrees.get_mut(target.index()) {
+                    *in_degree -= 1;
+                    if *in_degree == 0 {
+                        available_nodes.push(Reverse((self[target].load_order_index, target)));
+                    }
+                }
+            }
+        }
+
+        if sorted_nodes.len() < self.inner.node_count() {
+            let cyclic_node = self
+                .node_indices()
+                .find(|i| in_degrees.get(i.index()).is_some_and(|d| *d > 0));
+            if let Some(node_index) = cyclic_node {
+                return Err(SortingError::CycleInvolving(
+                    self[node_index].name().to_owned(),
+                ));
+            }
+        }
+
+        Ok(sorted_nodes)
+    }
+
     /// Returns the first pair of consecutive nodes that don't have an edge joining them.
     fn check_path_is_hamiltonian(&mut self, path: &[NodeIndex]) -> Option<(NodeIndex, NodeIndex)> {
         use std::ops::Not;
@@ -699,7 +1103,7 @@ impl<'a, T: SortingPlugin> PluginsGraph<'a, T> {
         logging::trace!("Checking uniqueness of path through plugin graph...");
 
         path.windows(2).find_map(|slice| match *slice {
-            [a, b] => self.inner.contains_edge(a, b).not().then_some((a, b)),
+            [a, b] => self.contains_edge(a, b).not().then_some((a, b)),
             _ => None,
         })
     }
@@ -713,8 +1117,7 @@ impl<'a, T: SortingPlugin> PluginsGraph<'a, T> {
     }
 
     fn node_index_by_name(&self, name: &str) -> Option<NodeIndex> {
-        self.node_indices()
-            .find(|i| unicase::eq(self[*i].name(), name))
+        self.node_indices_by_name.get(&UniCase::new(name)).copied()
     }
 
     fn path_exists(&mut self, from: NodeIndex, to: NodeIndex) -> bool {
@@ -724,7 +1127,7 @@ impl<'a, T: SortingPlugin> PluginsGraph<'a, T> {
 
         let mut visitor = PathCacher::new(&mut self.paths_cache, from, to);
 
-        bidirectional_bfs(&self.inner, from, to, &mut visitor)
+        bidirectional_bfs(&self.inner, &mut self.bfs_scratch, from, to, &mut visitor)
     }
 
     fn find_path(
@@ -734,7 +1137,13 @@ impl<'a, T: SortingPlugin> PluginsGraph<'a, T> {
     ) -> Result<Option<Vec<NodeIndex>>, PathfindingError> {
         let mut path_finder = PathFinder::new(&self.inner, &mut self.paths_cache, from, to);
 
-        if bidirectional_bfs(&self.inner, from, to, &mut path_finder) {
+        if bidirectional_bfs(
+            &self.inner,
+            &mut self.bfs_scratch,
+            from,
+            to,
+            &mut path_finder,
+        ) {
             path_finder.path()
         } else {
             Ok(None)
@@ -748,6 +1157,10 @@ impl<T: SortingPlugin> std::default::Default for PluginsGraph<'_, T> {
         Self {
             inner: Graph::default(),
             paths_cache: HashMap::default(),
+            sorted_successors: Vec::new(),
+            node_indices_by_name: HashMap::default(),
+            bfs_scratch: BidirBfsScratch::default(),
+            record_overlaps: None,
         }
     }
 }
@@ -760,10 +1173,51 @@ impl<'a, T: SortingPlugin> std::ops::Index<NodeIndex> for PluginsGraph<'a, T> {
     }
 }
 
+/// Calculate a fingerprint of the given inputs to [sort_plugins], so that a
+/// previous result can be reused if the same inputs are given again. The
+/// fingerprint is stable across builds of libloot, so can be persisted.
+pub fn sort_inputs_fingerprint<T: SortingPlugin>(
+    plugins_sorting_data: &[PluginSortingData<T>],
+    groups_graph: &GroupsGraph,
+    early_loading_plugins: &[String],
+    tie_break_strategy: TieBreakStrategy,
+) -> Result<u64, PluginDataError> {
+    let mut hasher = StableHasher::new();
+
+    hasher.write_usize(plugins_sorting_data.len());
+    for plugin in plugins_sorting_data {
+        plugin.hash_sorting_inputs(&mut hasher)?;
+    }
+
+    hasher.write_usize(groups_graph.node_count());
+    for node in groups_graph.node_indices() {
+        hasher.write_str(&groups_graph[node]);
+    }
+
+    hasher.write_usize(groups_graph.edge_count());
+    for edge in groups_graph.edge_references() {
+        hasher.write_usize(edge.source().index());
+        hasher.write_usize(edge.target().index());
+        hasher.write_str(&edge.weight().to_string());
+    }
+
+    hasher.write_strs(early_loading_plugins);
+    hasher.write_str(match tie_break_strategy {
+        TieBreakStrategy::LoadOrderPaths => "LoadOrderPaths",
+        TieBreakStrategy::LoadOrderPriority => "LoadOrderPriority",
+    });
+
+    Ok(hasher.finish())
+}
+
+/// Sort plugins, reusing and adding to the given record overlap results, if
+/// any. Without them, overlap results are not recorded.
 pub fn sort_plugins<T: SortingPlugin>(
     mut plugins_sorting_data: Vec<PluginSortingData<T>>,
     groups_graph: &GroupsGraph,
     early_loading_plugins: &[String],
+    mut record_overlaps: Option<&mut RecordOverlapCache>,
+    tie_break_strategy: TieBreakStrategy,
 ) -> Result<Vec<String>, SortingError> {
     if plugins_sorting_data.is_empty() {
         return Ok(Vec::new());
@@ -804,14 +1258,29 @@ pub fn sort_plugins<T: SortingPlugin>(
         early_loading_plugins,
     )?;
 
-    let mut masters_load_order =
-        sort_plugins_partition(masters, groups_graph, early_loading_plugins)?;
+    let mut masters_load_order = sort_plugins_partition(
+        masters,
+        groups_graph,
+        early_loading_plugins,
+        record_overlaps.as_deref_mut(),
+        tie_break_strategy,
+    )?;
 
-    let blueprint_masters_load_order =
-        sort_plugins_partition(blueprint_masters, groups_graph, early_loading_plugins)?;
+    let blueprint_masters_load_order = sort_plugins_partition(
+        blueprint_masters,
+        groups_graph,
+        early_loading_plugins,
+        record_overlaps.as_deref_mut(),
+        tie_break_strategy,
+    )?;
 
-    let non_masters_load_order =
-        sort_plugins_partition(non_masters, groups_graph, early_loading_plugins)?;
+    let non_masters_load_order = sort_plugins_partition(
+        non_masters,
+        groups_graph,
+        early_loading_plugins,
+        record_overlaps.as_deref_mut(),
+        tie_break_strategy,
+    )?;
 
     masters_load_order.extend(non_masters_load_order);
     masters_load_order.extend(blueprint_masters_load_order);
@@ -823,6 +1292,8 @@ fn sort_plugins_partition<T: SortingPlugin>(
     plugins_sorting_data: Vec<PluginSortingData<T>>,
     groups_graph: &GroupsGraph,
     early_loading_plugins: &[String],
+    record_overlaps: Option<&mut RecordOverlapCache>,
+    tie_break_strategy: TieBreakStrategy,
 ) -> Result<Vec<String>, SortingError> {
     let mut graph = PluginsGraph::new();
 
@@ -840,22 +1311,41 @@ fn sort_plugins_partition<T: SortingPlugin>(
     graph.check_for_cycles()?;
 
     graph.add_group_edges(groups_graph)?;
-    graph.add_overlap_edges()?;
-    graph.add_tie_break_edges()?;
 
-    // Check for cycles again, just in case there's a bug that lets some occur.
-    // The check doesn't take a significant amount of time.
-    graph.check_for_cycles()?;
+    // Lend any record overlap results to the graph while adding overlap edges,
+    // taking them back even if an error occurs.
+    match record_overlaps {
+        Some(record_overlaps) => {
+            graph.record_overlaps = Some(std::mem::take(record_overlaps));
+            let result = graph.add_overlap_edges();
+            *record_overlaps = graph.record_overlaps.take().unwrap_or_default();
+            result?;
+        }
+        None => graph.add_overlap_edges()?,
+    }
 
-    let sorted_nodes = graph.topological_sort()?;
+    let sorted_nodes = match tie_break_strategy {
+        TieBreakStrategy::LoadOrderPaths => {
+            graph.add_tie_break_edges()?;
 
-    if let Some((first, second)) = graph.check_path_is_hamiltonian(&sorted_nodes) {
-        logging::error!(
-            "The path is not unique. No edge exists between {} and {}",
-            graph[first].name(),
-            graph[second].name()
-        );
-    }
+            // Check for cycles again, just in case there's a bug that lets some
+            // occur. The check doesn't take a significant amount of time.
+            graph.check_for_cycles()?;
+
+            let sorted_nodes = graph.topological_sort()?;
+
+            if let Some((first, second)) = graph.check_path_is_hamiltonian(&sorted_nodes) {
+                logging::error!(
+                    "The path is not unique. No edge exists between {} and {}",
+                    graph[first].name(),
+                    graph[second].name()
+                );
+            }
+
+            sorted_nodes
+        }
+        TieBreakStrategy::LoadOrderPriority => graph.priority_topological_sort()?,
+    };
 
     let sorted_plugin_names = sorted_nodes
         .into_iter()
@@ -1363,6 +1853,32 @@ mod tests {
                 .unwrap()
         }
 
+        mod node_index_by_name {
+            use super::*;
+
+            #[test]
+            fn should_find_a_node_using_a_case_insensitive_comparison() {
+                let fixture = Fixture::with_plugins(&[PLUGIN_A, PLUGIN_B]);
+
+                let mut graph = PluginsGraph::new();
+                let a = graph.add_node(fixture.sorting_data(PLUGIN_A));
+                let b = graph.add_node(fixture.sorting_data(PLUGIN_B));
+
+                assert_eq!(Some(a), graph.node_index_by_name(PLUGIN_A));
+                assert_eq!(Some(b), graph.node_index_by_name(&PLUGIN_B.to_uppercase()));
+            }
+
+            #[test]
+            fn should_return_none_if_no_node_has_the_given_name() {
+                let fixture = Fixture::with_plugins(&[PLUGIN_A, PLUGIN_B]);
+
+                let mut graph = PluginsGraph::new();
+                graph.add_node(fixture.sorting_data(PLUGIN_A));
+
+                assert!(graph.node_index_by_name(PLUGIN_B).is_none());
+            }
+        }
+
         mod check_for_cycles {
             use super::*;
 
@@ -1434,6 +1950,35 @@ mod tests {
             assert!(sorted.is_empty());
         }
 
+        #[test]
+        fn contains_edge_should_only_be_true_for_edges_that_have_been_added() {
+            let fixture = Fixture::with_plugins(&[PLUGIN_A, PLUGIN_B, PLUGIN_C, PLUGIN_D]);
+
+            let mut graph = PluginsGraph::<TestPlugin>::new();
+            let a = graph.add_node(fixture.sorting_data(PLUGIN_A));
+            let b = graph.add_node(fixture.sorting_data(PLUGIN_B));
+            let c = graph.add_node(fixture.sorting_data(PLUGIN_C));
+            let d = graph.add_node(fixture.sorting_data(PLUGIN_D));
+
+            graph.add_edge(a, d, EdgeType::Master);
+            graph.add_edge(a, b, EdgeType::Master);
+            graph.add_edge(c, b, EdgeType::Master);
+
+            for from in [a, b, c, d] {
+                for to in [a, b, c, d] {
+                    assert_eq!(
+                        graph.inner.contains_edge(from, to),
+                        graph.contains_edge(from, to)
+                    );
+                }
+            }
+            assert!(graph.contains_edge(a, b));
+            assert!(graph.contains_edge(a, d));
+            assert!(graph.contains_edge(c, b));
+            assert!(!graph.contains_edge(b, a));
+            assert!(!graph.contains_edge(a, c));
+        }
+
         mod add_early_loading_plugin_edges {
             use super::*;
 
@@ -2932,6 +3477,117 @@ mod tests {
                 assert!(!graph.inner.contains_edge(b, a));
             }
 
+            #[test]
+            fn should_use_cached_record_overlap_results() {
+                let mut fixture = Fixture::with_plugins(&[PLUGIN_A, PLUGIN_B]);
+
+                fixture.get_plugin_mut(PLUGIN_A).override_record_count = 2;
+                fixture.get_plugin_mut(PLUGIN_B).override_record_count = 1;
+
+                let mut graph = PluginsGraph::<TestPlugin>::new();
+                let a = graph.add_node(fixture.sorting_data(PLUGIN_A));
+                let b = graph.add_node(fixture.sorting_data(PLUGIN_B));
+
+                let mut record_overlaps = RecordOverlapCache::default();
+                record_overlaps
+                    .get_or_try_insert_with::<PluginDataError>(PLUGIN_A, PLUGIN_B, || Ok(true))
+                    .unwrap();
+                graph.record_overlaps = Some(record_overlaps);
+
+                graph.add_overlap_edges().unwrap();
+
+                assert_eq!(EdgeType::RecordOverlap, edge_type(&graph, a, b));
+            }
+
+            #[test]
+            fn should_not_use_cached_record_overlap_results_for_removed_plugins() {
+                let mut fixture = Fixture::with_plugins(&[PLUGIN_A, PLUGIN_B]);
+
+                fixture.get_plugin_mut(PLUGIN_A).override_record_count = 2;
+                fixture.get_plugin_mut(PLUGIN_B).override_record_count = 1;
+
+                let mut graph = PluginsGraph::<TestPlugin>::new();
+                let a = graph.add_node(fixture.sorting_data(PLUGIN_A));
+                let b = graph.add_node(fixture.sorting_data(PLUGIN_B));
+
+                let mut record_overlaps = RecordOverlapCache::default();
+                record_overlaps
+                    .get_or_try_insert_with::<PluginDataError>(PLUGIN_A, PLUGIN_B, || Ok(true))
+                    .unwrap();
+                record_overlaps.remove_plugin(&PLUGIN_B.to_uppercase());
+                graph.record_overlaps = Some(record_overlaps);
+
+                graph.add_overlap_edges().unwrap();
+
+                assert!(!graph.inner.contains_edge(a, b));
+                assert!(!graph.inner.contains_edge(b, a));
+            }
+
+            #[test]
+            fn should_add_edge_between_overlapping_plugins_with_namespaced_record_ids_and_a_shared_master()
+             {
+                let mut fixture = Fixture::with_plugins(&[PLUGIN_A, PLUGIN_B]);
+
+                let a = fixture.get_plugin_mut(PLUGIN_A);
+                a.has_namespaced_record_ids = true;
+                a.override_record_count = 2;
+                a.add_master(PLUGIN_C);
+                a.add_overlapping_records(PLUGIN_B);
+
+                let b = fixture.get_plugin_mut(PLUGIN_B);
+                b.has_namespaced_record_ids = true;
+                b.override_record_count = 1;
+                b.add_master(PLUGIN_C);
+
+                let mut graph = PluginsGraph::<TestPlugin>::new();
+                let a = graph.add_node(fixture.sorting_data(PLUGIN_A));
+                let b = graph.add_node(fixture.sorting_data(PLUGIN_B));
+
+                graph.add_overlap_edges().unwrap();
+
+                assert_eq!(EdgeType::RecordOverlap, edge_type(&graph, a, b));
+                assert!(!graph.inner.contains_edge(b, a));
+            }
+
+            #[test]
+            fn find_record_overlap_candidates_should_only_pair_plugins_with_namespaced_record_ids_that_share_an_origin()
+             {
+                let mut fixture = Fixture::with_plugins(&[PLUGIN_A, PLUGIN_B, PLUGIN_C, PLUGIN_D]);
+
+                // A has no override records, so only B (which has A as a master) can
+                // override its records.
+                let a = fixture.get_plugin_mut(PLUGIN_A);
+                a.has_namespaced_record_ids = true;
+                a.add_master(PLUGIN_E);
+
+                let b = fixture.get_plugin_mut(PLUGIN_B);
+                b.has_namespaced_record_ids = true;
+                b.override_record_count = 1;
+                b.add_master(PLUGIN_A);
+
+                let c = fixture.get_plugin_mut(PLUGIN_C);
+                c.has_namespaced_record_ids = true;
+                c.override_record_count = 1;
+                c.add_master(PLUGIN_E);
+
+                // D's record IDs aren't namespaced, so it could overlap with any plugin.
+                fixture.get_plugin_mut(PLUGIN_D).override_record_count = 1;
+
+                let mut graph = PluginsGraph::<TestPlugin>::new();
+                let a = graph.add_node(fixture.sorting_data(PLUGIN_A));
+                let b = graph.add_node(fixture.sorting_data(PLUGIN_B));
+                let c = graph.add_node(fixture.sorting_data(PLUGIN_C));
+                let d = graph.add_node(fixture.sorting_data(PLUGIN_D));
+
+                let candidates = graph.find_record_overlap_candidates().unwrap();
+
+                assert_eq!(4, candidates.len());
+                assert!(candidates.contains(&(a, b)));
+                assert!(candidates.contains(&(a, d)));
+                assert!(candidates.contains(&(b, d)));
+                assert!(candidates.contains(&(c, d)));
+            }
+
             #[test]
             fn should_not_add_edge_between_non_overlapping_plugins_with_unequal_override_counts() {
                 let mut fixture = Fixture::with_plugins(&[PLUGIN_A, PLUGIN_B]);
@@ -3062,6 +3718,33 @@ mod tests {
                 assert!(!graph.inner.contains_edge(b, a));
             }
 
+            #[test]
+            fn find_asset_overlaps_should_only_pair_plugins_that_share_assets() {
+                let mut fixture = Fixture::with_plugins(&[PLUGIN_A, PLUGIN_B, PLUGIN_C]);
+
+                // A loads C's unique asset and C loads B's unique asset, so A
+                // and B don't share any assets. If A and B were both given C
+                // as overlapping, they'd both load C's unique asset and so
+                // overlap with each other.
+                fixture
+                    .get_plugin_mut(PLUGIN_A)
+                    .add_overlapping_assets(PLUGIN_C);
+                fixture
+                    .get_plugin_mut(PLUGIN_C)
+                    .add_overlapping_assets(PLUGIN_B);
+
+                let mut graph = PluginsGraph::<TestPlugin>::new();
+                let a = graph.add_node(fixture.sorting_data(PLUGIN_A));
+                let b = graph.add_node(fixture.sorting_data(PLUGIN_B));
+                let c = graph.add_node(fixture.sorting_data(PLUGIN_C));
+
+                let overlaps = graph.find_asset_overlaps();
+
+                assert_eq!(2, overlaps.len());
+                assert!(overlaps.contains(&(a, c)));
+                assert!(overlaps.contains(&(b, c)));
+            }
+
             #[test]
             fn should_choose_record_overlap_over_asset_overlap() {
                 let mut fixture = Fixture::with_plugins(&[PLUGIN_A, PLUGIN_B]);
@@ -3229,13 +3912,397 @@ mod tests {
                 );
             }
         }
-    }
 
-    mod sort_plugins {
-        use crate::{Vertex, sorting::error::PluginGraphValidationError};
+        mod priority_topological_sort {
+            use super::*;
 
+            #[test]
+            fn should_return_the_current_load_order_if_it_is_already_sorted() {
+                let fixture = Fixture::with_plugins(&[PLUGIN_A, PLUGIN_B, PLUGIN_C]);
+
+                let mut graph = PluginsGraph::<TestPlugin>::new();
+                let a = graph.add_node(fixture.sorting_data(PLUGIN_A));
+                let b = graph.add_node(fixture.sorting_data(PLUGIN_B));
+                let c = graph.add_node(fixture.sorting_data(PLUGIN_C));
+
+                graph.add_edge(a, c, EdgeType::Master);
+
+                let sorted = graph.priority_topological_sort().unwrap();
+
+                assert_eq!(&[a, b, c], sorted.as_slice());
+            }
+
+            #[test]
+            fn should_load_the_earliest_available_plugin_next() {
+                let fixture = Fixture::with_plugins(&[PLUGIN_A, PLUGIN_B, PLUGIN_C]);
+
+                let mut graph = PluginsGraph::<TestPlugin>::new();
+                let a = graph.add_node(fixture.sorting_data(PLUGIN_A));
+                let b = graph.add_node(fixture.sorting_data(PLUGIN_B));
+                let c = graph.add_node(fixture.sorting_data(PLUGIN_C));
+
+                graph.add_edge(c, a, EdgeType::Master);
+
+                let sorted = graph.priority_topological_sort().unwrap();
+
+                assert_eq!(&[b, c, a], sorted.as_slice());
+            }
+
+            #[test]
+            fn should_use_load_order_index_and_not_node_index() {
+                let fixture = Fixture::with_plugins(&[PLUGIN_C, PLUGIN_B, PLUGIN_A]);
+
+                let mut graph = PluginsGraph::<TestPlugin>::new();
+                let a = graph.add_node(fixture.sorting_data(PLUGIN_A));
+                let b = graph.add_node(fixture.sorting_data(PLUGIN_B));
+                let c = graph.add_node(fixture.sorting_data(PLUGIN_C));
+
+                let sorted = graph.priority_topological_sort().unwrap();
+
+                assert_eq!(&[c, b, a], sorted.as_slice());
+            }
+
+            #[test]
+            fn should_error_if_there_is_a_cycle() {
+                let fixture = Fixture::with_plugins(&[PLUGIN_A, PLUGIN_B, PLUGIN_C]);
+
+                let mut graph = PluginsGraph::<TestPlugin>::new();
+                let a = graph.add_node(fixture.sorting_data(PLUGIN_A));
+                let b = graph.add_node(fixture.sorting_data(PLUGIN_B));
+                graph.add_node(fixture.sorting_data(PLUGIN_C));
+
+                graph.add_edge(a, b, EdgeType::Master);
+                graph.add_edge(b, a, EdgeType::Master);
+
+                assert!(matches!(
+                    graph.priority_topological_sort(),
+                    Err(SortingError::CycleInvolving(_))
+                ));
+            }
+        }
+    }
+
+    mod sort_inputs_fingerprint {
         use super::*;
 
+        #[test]
+        fn should_be_equal_for_equal_inputs() {
+            let fixture = Fixture::with_plugins(&[PLUGIN_A, PLUGIN_B]);
+
+            let data = [
+                fixture.sorting_data(PLUGIN_A),
+                fixture.sorting_data(PLUGIN_B),
+            ];
+            let first = sort_inputs_fingerprint(
+                &data,
+                &fixture.groups_graph,
+                &[],
+                TieBreakStrategy::default(),
+            )
+            .unwrap();
+            let second = sort_inputs_fingerprint(
+                &data,
+                &fixture.groups_graph,
+                &[],
+                TieBreakStrategy::default(),
+            )
+            .unwrap();
+
+            assert_eq!(first, second);
+        }
+
+        #[test]
+        fn should_change_if_the_tie_break_strategy_changes() {
+            let fixture = Fixture::with_plugins(&[PLUGIN_A, PLUGIN_B]);
+
+            let data = [
+                fixture.sorting_data(PLUGIN_A),
+                fixture.sorting_data(PLUGIN_B),
+            ];
+            let first = sort_inputs_fingerprint(
+                &data,
+                &fixture.groups_graph,
+                &[],
+                TieBreakStrategy::LoadOrderPaths,
+            )
+            .unwrap();
+            let second = sort_inputs_fingerprint(
+                &data,
+                &fixture.groups_graph,
+                &[],
+                TieBreakStrategy::LoadOrderPriority,
+            )
+            .unwrap();
+
+            assert_ne!(first, second);
+        }
+
+        #[test]
+        fn should_change_if_the_input_order_changes() {
+            let fixture = Fixture::with_plugins(&[PLUGIN_A, PLUGIN_B]);
+
+            let data = [
+                fixture.sorting_data(PLUGIN_A),
+                fixture.sorting_data(PLUGIN_B),
+            ];
+            let first = sort_inputs_fingerprint(
+                &data,
+                &fixture.groups_graph,
+                &[],
+                TieBreakStrategy::default(),
+            )
+            .unwrap();
+
+            let data = [
+                fixture.sorting_data(PLUGIN_B),
+                fixture.sorting_data(PLUGIN_A),
+            ];
+            let second = sort_inputs_fingerprint(
+                &data,
+                &fixture.groups_graph,
+                &[],
+                TieBreakStrategy::default(),
+            )
+            .unwrap();
+
+            assert_ne!(first, second);
+        }
+
+        #[test]
+        fn should_change_if_plugin_metadata_changes() {
+            let fixture = Fixture::with_plugins(&[PLUGIN_A, PLUGIN_B]);
+
+            let data = [
+                fixture.sorting_data(PLUGIN_A),
+                fixture.sorting_data(PLUGIN_B),
+            ];
+            let first = sort_inputs_fingerprint(
+                &data,
+                &fixture.groups_graph,
+                &[],
+                TieBreakStrategy::default(),
+            )
+            .unwrap();
+
+            let data = [
+                fixture.sorting_data(PLUGIN_A),
+                fixture.group_sorting_data(PLUGIN_B, "B"),
+            ];
+            let second = sort_inputs_fingerprint(
+                &data,
+                &fixture.groups_graph,
+                &[],
+                TieBreakStrategy::default(),
+            )
+            .unwrap();
+
+            assert_ne!(first, second);
+        }
+
+        #[test]
+        fn should_change_if_early_loading_plugins_change() {
+            let fixture = Fixture::with_plugins(&[PLUGIN_A, PLUGIN_B]);
+
+            let data = [
+                fixture.sorting_data(PLUGIN_A),
+                fixture.sorting_data(PLUGIN_B),
+            ];
+            let first = sort_inputs_fingerprint(
+                &data,
+                &fixture.groups_graph,
+                &[],
+                TieBreakStrategy::default(),
+            )
+            .unwrap();
+            let second = sort_inputs_fingerprint(
+                &data,
+                &fixture.groups_graph,
+                &[PLUGIN_A.into()],
+                TieBreakStrategy::default(),
+            )
+            .unwrap();
+
+            assert_ne!(first, second);
+        }
+    }
+
+    mod sort_plugins {
+        use crate::{Vertex, sorting::error::PluginGraphValidationError};
+
+        use super::*;
+
+        /// Checks that the two tie break strategies agree on the properties
+        /// that any sorted load order must have, using large synthetic load
+        /// orders. The strategies are allowed to position plugins differently
+        /// when the current load order must change, so their results are only
+        /// compared directly when they must be the same.
+        mod tie_break_strategies {
+            use super::*;
+
+            const PLUGIN_COUNT: usize = 200;
+            const MAX_MASTER_COUNT: usize = 4;
+            const SEEDS: [u64; 4] = [0x9E37_79B9, 0x2545_F491, 0x5851_F42D, 0x1405_7B7E];
+
+            /// A xorshift generator, so that the synthetic load orders are
+            /// reproducible.
+            struct Rng(u64);
+
+            impl Rng {
+                fn next(&mut self) -> u64 {
+                    self.0 ^= self.0 << 13;
+                    self.0 ^= self.0 >> 7;
+                    self.0 ^= self.0 << 17;
+                    self.0
+                }
+
+                /// Get a number in the range [0, n).
+                fn below(&mut self, n: usize) -> usize {
+                    let n = u128::try_from(n).unwrap();
+                    usize::try_from((u128::from(self.next()) * n) >> 64).unwrap()
+                }
+
+                fn shuffle<T>(&mut self, items: &mut [T]) {
+                    for i in (1..items.len()).rev() {
+                        items.swap(i, self.below(i + 1));
+                    }
+                }
+            }
+
+            fn plugin_names() -> Vec<String> {
+                (0..PLUGIN_COUNT).map(|i| format!("{i:03}.esp")).collect()
+            }
+
+            /// Create plugins that can only load in ascending order of their
+            /// names' numbers, given the load order they're currently in.
+            fn synthetic_fixture(seed: u64, load_order: &[String]) -> Fixture {
+                let mut rng = Rng(seed);
+                let names = plugin_names();
+                let load_order: Vec<_> = load_order.iter().map(String::as_str).collect();
+
+                let mut fixture = Fixture::with_plugins(&load_order);
+                for (i, name) in names.iter().enumerate().skip(1) {
+                    let plugin = fixture.get_plugin_mut(name);
+                    plugin.override_record_count = rng.below(PLUGIN_COUNT);
+
+                    for _ in 0..rng.below(MAX_MASTER_COUNT) {
+                        plugin.add_master(&names[rng.below(i)]);
+                    }
+
+                    // Overlaps can go in either direction.
+                    plugin.add_overlapping_records(&names[rng.below(PLUGIN_COUNT)]);
+                }
+
+                fixture
+            }
+
+            fn sort(fixture: &Fixture, strategy: TieBreakStrategy) -> Vec<String> {
+                let data = plugin_names()
+                    .iter()
+                    .map(|n| fixture.sorting_data(n))
+                    .collect();
+
+                sort_plugins(data, &fixture.groups_graph, &[], None, strategy).unwrap()
+            }
+
+            /// Build a graph with all the edges that sorting adds before
+            /// breaking ties, which both strategies must respect.
+            fn constraints_graph(fixture: &Fixture) -> PluginsGraph<'_, TestPlugin> {
+                let mut graph = PluginsGraph::new();
+                for name in plugin_names() {
+                    graph.add_node(fixture.sorting_data(&name));
+                }
+
+                graph.add_specific_edges().unwrap();
+                graph.add_group_edges(&fixture.groups_graph).unwrap();
+                graph.add_overlap_edges().unwrap();
+
+                graph
+            }
+
+            fn assert_edges_are_respected(
+                graph: &PluginsGraph<'_, TestPlugin>,
+                sorted: &[String],
+                strategy: TieBreakStrategy,
+            ) {
+                let mut expected = plugin_names();
+                let mut actual = sorted.to_vec();
+                expected.sort();
+                actual.sort();
+                assert_eq!(expected, actual);
+
+                let position = |index: NodeIndex| {
+                    let name = graph[index].name();
+                    sorted.iter().position(|n| n == name).unwrap()
+                };
+
+                for edge in graph.inner.edge_references() {
+                    assert!(
+                        position(edge.source()) < position(edge.target()),
+                        "{} does not load before {} when sorted using {strategy:?}",
+                        graph[edge.source()].name(),
+                        graph[edge.target()].name()
+                    );
+                }
+            }
+
+            #[test]
+            fn should_give_valid_load_orders_when_plugins_need_to_move() {
+                for seed in SEEDS {
+                    let mut load_order = plugin_names();
+                    Rng(seed).shuffle(&mut load_order);
+                    let fixture = synthetic_fixture(seed, &load_order);
+                    let graph = constraints_graph(&fixture);
+
+                    let position = |name: &str| load_order.iter().position(|n| n == name);
+                    let needs_moves = graph.inner.edge_references().any(|e| {
+                        position(graph[e.source()].name()) > position(graph[e.target()].name())
+                    });
+                    assert!(
+                        needs_moves,
+                        "seed {seed:#x} gave an already-sorted load order"
+                    );
+
+                    let paths = sort(&fixture, TieBreakStrategy::LoadOrderPaths);
+                    let priority = sort(&fixture, TieBreakStrategy::LoadOrderPriority);
+
+                    assert_edges_are_respected(&graph, &paths, TieBreakStrategy::LoadOrderPaths);
+                    assert_edges_are_respected(
+                        &graph,
+                        &priority,
+                        TieBreakStrategy::LoadOrderPriority,
+                    );
+                }
+            }
+
+            #[test]
+            fn should_both_keep_a_load_order_that_is_already_sorted() {
+                for seed in SEEDS {
+                    let mut load_order = plugin_names();
+                    Rng(seed).shuffle(&mut load_order);
+                    let fixture = synthetic_fixture(seed, &load_order);
+
+                    for strategy in [
+                        TieBreakStrategy::LoadOrderPaths,
+                        TieBreakStrategy::LoadOrderPriority,
+                    ] {
+                        let sorted = sort(&fixture, strategy);
+                        let fixture = synthetic_fixture(seed, &sorted);
+
+                        assert_eq!(
+                            sorted,
+                            sort(&fixture, TieBreakStrategy::LoadOrderPaths),
+                            "seed {seed}, sorted using {strategy:?}"
+                        );
+                        assert_eq!(
+                            sorted,
+                            sort(&fixture, TieBreakStrategy::LoadOrderPriority),
+                            "seed {seed}, sorted using {strategy:?}"
+                        );
+                    }
+                }
+            }
+        }
+
         #[test]
         fn should_not_change_the_result_if_given_its_own_output() {
             let fixture = Fixture::with_plugins(&[PLUGIN_A, PLUGIN_B]);
@@ -3249,6 +4316,8 @@ mod tests {
                 ],
                 &fixture.groups_graph,
                 &[],
+                None,
+                TieBreakStrategy::default(),
             )
             .unwrap();
 
@@ -3261,6 +4330,8 @@ mod tests {
                 ],
                 &fixture.groups_graph,
                 &[],
+                None,
+                TieBreakStrategy::default(),
             )
             .unwrap();
 
@@ -3278,7 +4349,14 @@ mod tests {
 
             let expected = &[PLUGIN_A, PLUGIN_B];
 
-            let sorted = sort_plugins(data, &fixture.groups_graph, &[]).unwrap();
+            let sorted = sort_plugins(
+                data,
+                &fixture.groups_graph,
+                &[],
+                None,
+                TieBreakStrategy::default(),
+            )
+            .unwrap();
 
             assert_eq!(expected, sorted.as_slice());
         }
@@ -3294,7 +4372,14 @@ mod tests {
 
             let expected = &[PLUGIN_B, PLUGIN_A];
 
-            let sorted = sort_plugins(data, &fixture.groups_graph, &[]).unwrap();
+            let sorted = sort_plugins(
+                data,
+                &fixture.groups_graph,
+                &[],
+                None,
+                TieBreakStrategy::default(),
+            )
+            .unwrap();
 
             assert_eq!(expected, sorted.as_slice());
         }
@@ -3310,7 +4395,14 @@ mod tests {
 
             let expected = &[PLUGIN_B, PLUGIN_A];
 
-            let sorted = sort_plugins(data, &fixture.groups_graph, &[]).unwrap();
+            let sorted = sort_plugins(
+                data,
+                &fixture.groups_graph,
+                &[],
+                None,
+                TieBreakStrategy::default(),
+            )
+            .unwrap();
 
             assert_eq!(expected, sorted.as_slice());
         }
@@ -3326,7 +4418,14 @@ mod tests {
 
             let expected = &[PLUGIN_A, PLUGIN_B];
 
-            let sorted = sort_plugins(data, &fixture.groups_graph, &[PLUGIN_A.into()]).unwrap();
+            let sorted = sort_plugins(
+                data,
+                &fixture.groups_graph,
+                &[PLUGIN_A.into()],
+                None,
+                TieBreakStrategy::default(),
+            )
+            .unwrap();
 
             assert_eq!(expected, sorted.as_slice());
         }
@@ -3337,7 +4436,16 @@ mod tests {
 
             let data = vec![fixture.group_sorting_data(PLUGIN_A, "missing")];
 
-            assert!(sort_plugins(data, &fixture.groups_graph, &[]).is_err());
+            assert!(
+                sort_plugins(
+                    data,
+                    &fixture.groups_graph,
+                    &[],
+                    None,
+                    TieBreakStrategy::default(),
+                )
+                .is_err()
+            );
         }
 
         #[test]
@@ -3352,7 +4460,13 @@ mod tests {
                 fixture.sorting_data(PLUGIN_B),
             ];
 
-            match sort_plugins(data, &fixture.groups_graph, &[]) {
+            match sort_plugins(
+                data,
+                &fixture.groups_graph,
+                &[],
+                None,
+                TieBreakStrategy::default(),
+            ) {
                 Err(SortingError::CycleFound(e)) => {
                     assert_eq!(
                         &[
@@ -3379,7 +4493,13 @@ mod tests {
                 fixture.sorting_data(PLUGIN_B),
             ];
 
-            match sort_plugins(data, &fixture.groups_graph, &[]) {
+            match sort_plugins(
+                data,
+                &fixture.groups_graph,
+                &[],
+                None,
+                TieBreakStrategy::default(),
+            ) {
                 Err(SortingError::ValidationError(PluginGraphValidationError::CycleFound(e))) => {
                     assert_eq!(
                         &[
@@ -3404,7 +4524,13 @@ mod tests {
 
             let data = vec![a, fixture.sorting_data(PLUGIN_B)];
 
-            match sort_plugins(data, &fixture.groups_graph, &[]) {
+            match sort_plugins(
+                data,
+                &fixture.groups_graph,
+                &[],
+                None,
+                TieBreakStrategy::default(),
+            ) {
                 Err(SortingError::ValidationError(PluginGraphValidationError::CycleFound(e))) => {
                     assert_eq!(
                         &[
@@ -3430,7 +4556,13 @@ mod tests {
 
             let data = vec![a, fixture.sorting_data(PLUGIN_B)];
 
-            match sort_plugins(data, &fixture.groups_graph, &[]) {
+            match sort_plugins(
+                data,
+                &fixture.groups_graph,
+                &[],
+                None,
+                TieBreakStrategy::default(),
+            ) {
                 Err(SortingError::ValidationError(PluginGraphValidationError::CycleFound(e))) => {
                     assert_eq!(
                         &[
@@ -3456,7 +4588,13 @@ mod tests {
 
             let data = vec![a, fixture.sorting_data(PLUGIN_B)];
 
-            match sort_plugins(data, &fixture.groups_graph, &[]) {
+            match sort_plugins(
+                data,
+                &fixture.groups_graph,
+                &[],
+                None,
+                TieBreakStrategy::default(),
+            ) {
                 Err(SortingError::ValidationError(PluginGraphValidationError::CycleFound(e))) => {
                     assert_eq!(
                         &[
@@ -3482,7 +4620,13 @@ mod tests {
 
             let data = vec![a, fixture.sorting_data(PLUGIN_B)];
 
-            match sort_plugins(data, &fixture.groups_graph, &[]) {
+            match sort_plugins(
+                data,
+                &fixture.groups_graph,
+                &[],
+                None,
+                TieBreakStrategy::default(),
+            ) {
                 Err(SortingError::ValidationError(PluginGraphValidationError::CycleFound(e))) => {
                     assert_eq!(
                         &[
@@ -3508,7 +4652,13 @@ mod tests {
                 fixture.sorting_data(PLUGIN_B),
             ];
 
-            match sort_plugins(data, &fixture.groups_graph, &[PLUGIN_B.into()]) {
+            match sort_plugins(
+                data,
+                &fixture.groups_graph,
+                &[PLUGIN_B.into()],
+                None,
+                TieBreakStrategy::default(),
+            ) {
                 Err(SortingError::ValidationError(PluginGraphValidationError::CycleFound(e))) => {
                     assert_eq!(
                         &[
@@ -3541,7 +4691,14 @@ mod tests {
 
             let expected = &[PLUGIN_B, PLUGIN_A];
 
-            let sorted = sort_plugins(data, &fixture.groups_graph, &[]).unwrap();
+            let sorted = sort_plugins(
+                data,
+                &fixture.groups_graph,
+                &[],
+                None,
+                TieBreakStrategy::default(),
+            )
+            .unwrap();
 
             assert_eq!(expected, sorted.as_slice());
         }
@@ -3563,7 +4720,14 @@ mod tests {
 
             let expected = &[PLUGIN_B, PLUGIN_A];
 
-            let sorted = sort_plugins(data, &fixture.groups_graph, &[]).unwrap();
+            let sorted = sort_plugins(
+                data,
+                &fixture.groups_graph,
+                &[],
+                None,
+                TieBreakStrategy::default(),
+            )
+            .unwrap();
 
             assert_eq!(expected, sorted.as_slice());
         }
@@ -3583,7 +4747,13 @@ mod tests {
 
             let data = vec![a, fixture.sorting_data(PLUGIN_B)];
 
-            match sort_plugins(data, &fixture.groups_graph, &[]) {
+            match sort_plugins(
+                data,
+                &fixture.groups_graph,
+                &[],
+                None,
+                TieBreakStrategy::default(),
+            ) {
                 Err(SortingError::ValidationError(PluginGraphValidationError::CycleFound(e))) => {
                     assert_eq!(
                         &[
@@ -3613,7 +4783,13 @@ mod tests {
 
             let data = vec![a, fixture.sorting_data(PLUGIN_B)];
 
-            match sort_plugins(data, &fixture.groups_graph, &[]) {
+            match sort_plugins(
+                data,
+                &fixture.groups_graph,
+                &[],
+                None,
+                TieBreakStrategy::default(),
+            ) {
                 Err(SortingError::ValidationError(PluginGraphValidationError::CycleFound(e))) => {
                     assert_eq!(
                         &[
@@ -3644,7 +4820,13 @@ mod tests {
 
             let data = vec![a, fixture.sorting_data(PLUGIN_B)];
 
-            match sort_plugins(data, &fixture.groups_graph, &[]) {
+            match sort_plugins(
+                data,
+                &fixture.groups_graph,
+                &[],
+                None,
+                TieBreakStrategy::default(),
+            ) {
                 Err(SortingError::ValidationError(PluginGraphValidationError::CycleFound(e))) => {
                     assert_eq!(
                         &[
@@ -3673,7 +4855,13 @@ mod tests {
 
             let data = vec![a, fixture.sorting_data(PLUGIN_B)];
 
-            match sort_plugins(data, &fixture.groups_graph, &[]) {
+            match sort_plugins(
+                data,
+                &fixture.groups_graph,
+                &[],
+                None,
+                TieBreakStrategy::default(),
+            ) {
                 Err(SortingError::ValidationError(PluginGraphValidationError::CycleFound(e))) => {
                     assert_eq!(
                         &[
@@ -3704,7 +4892,13 @@ mod tests {
 
             let data = vec![a, fixture.sorting_data(PLUGIN_B)];
 
-            match sort_plugins(data, &fixture.groups_graph, &[]) {
+            match sort_plugins(
+                data,
+                &fixture.groups_graph,
+                &[],
+                None,
+                TieBreakStrategy::default(),
+            ) {
                 Err(SortingError::ValidationError(PluginGraphValidationError::CycleFound(e))) => {
                     assert_eq!(
                         &[
@@ -3734,7 +4928,13 @@ mod tests {
 
             let data = vec![a, fixture.sorting_data(PLUGIN_B)];
 
-            match sort_plugins(data, &fixture.groups_graph, &[]) {
+            match sort_plugins(
+                data,
+                &fixture.groups_graph,
+                &[],
+                None,
+                TieBreakStrategy::default(),
+            ) {
                 Err(SortingError::ValidationError(PluginGraphValidationError::CycleFound(e))) => {
                     assert_eq!(
                         &[
@@ -3765,7 +4965,13 @@ mod tests {
 
             let data = vec![a, fixture.sorting_data(PLUGIN_B)];
 
-            match sort_plugins(data, &fixture.groups_graph, &[]) {
+            match sort_plugins(
+                data,
+                &fixture.groups_graph,
+                &[],
+                None,
+                TieBreakStrategy::default(),
+            ) {
                 Err(SortingError::ValidationError(PluginGraphValidationError::CycleFound(e))) => {
                     assert_eq!(
                         &[
@@ -3794,7 +5000,13 @@ mod tests {
 
             let data = vec![a, fixture.sorting_data(PLUGIN_B)];
 
-            match sort_plugins(data, &fixture.groups_graph, &[]) {
+            match sort_plugins(
+                data,
+                &fixture.groups_graph,
+                &[],
+                None,
+                TieBreakStrategy::default(),
+            ) {
                 Err(SortingError::ValidationError(PluginGraphValidationError::CycleFound(e))) => {
                     assert_eq!(
                         &[
@@ -3827,7 +5039,14 @@ mod tests {
 
             let expected = &[PLUGIN_A, PLUGIN_B];
 
-            let sorted = sort_plugins(data, &fixture.groups_graph, &[PLUGIN_B.into()]).unwrap();
+            let sorted = sort_plugins(
+                data,
+                &fixture.groups_graph,
+                &[PLUGIN_B.into()],
+                None,
+                TieBreakStrategy::default(),
+            )
+            .unwrap();
 
             assert_eq!(expected, sorted.as_slice());
         }
@@ -3847,7 +5066,14 @@ mod tests {
 
             let expected = &[PLUGIN_A, PLUGIN_B];
 
-            let sorted = sort_plugins(data, &fixture.groups_graph, &[PLUGIN_B.into()]).unwrap();
+            let sorted = sort_plugins(
+                data,
+                &fixture.groups_graph,
+                &[PLUGIN_B.into()],
+                None,
+                TieBreakStrategy::default(),
+            )
+            .unwrap();
 
             assert_eq!(expected, sorted.as_slice());
         }
@@ -0,0 +1,399 @@
+use std::{
+    collections::VecDeque,
+    fs::File,
+    io::{BufRead, BufReader, BufWriter, Write},
+    path::{Path, PathBuf},
+    sync::Mutex,
+};
+
+use rustc_hash::FxHashMap as HashMap;
+
+use crate::logging;
+
+// The format version is followed by the libloot version because a different
+// version of libloot may sort the same inputs differently.
+const FILE_HEADER: &str = concat!("libloot sort result cache v2 ", env!("CARGO_PKG_VERSION"));
+const MAX_ENTRIES: usize = 128;
+
+// Plugin filenames can't contain forward slashes on any supported platform.
+const NAME_SEPARATOR: &str = "/";
+
+/// A 64-bit FNV-1a hasher for calculating fingerprints that are stored in
+/// the cache file. Unlike std's DefaultHasher and Hash implementations, its
+/// output is specified, so it doesn't change between builds of libloot.
+/// Values are written with explicit encodings for the same reason.
+#[derive(Clone, Copy, Debug)]
+pub struct StableHasher(u64);
+
+impl StableHasher {
+    const OFFSET_BASIS: u64 = 0xCBF2_9CE4_8422_2325;
+    const PRIME: u64 = 0x0100_0000_01B3;
+
+    pub fn new() -> Self {
+        Self(Self::OFFSET_BASIS)
+    }
+
+    pub fn write_bytes(&mut self, bytes: &[u8]) {
+        for byte in bytes {
+            self.0 ^= u64::from(*byte);
+            self.0 = self.0.wrapping_mul(Self::PRIME);
+        }
+    }
+
+    pub fn write_bool(&mut self, value: bool) {
+        self.write_bytes(&[u8::from(value)]);
+    }
+
+    pub fn write_u64(&mut self, value: u64) {
+        self.write_bytes(&value.to_le_bytes());
+    }
+
+    pub fn write_usize(&mut self, value: usize) {
+        self.write_u64(u64::try_from(value).unwrap_or(u64::MAX));
+    }
+
+    /// Write a string prefixed by its length, so that adjacent strings can't
+    /// run into each other.
+    pub fn write_str(&mut self, value: &str) {
+        self.write_usize(value.len());
+        self.write_bytes(value.as_bytes());
+    }
+
+    pub fn write_strs<S: AsRef<str>>(&mut self, values: &[S]) {
+        self.write_usize(values.len());
+        for value in values {
+            self.write_str(value.as_ref());
+        }
+    }
+
+    pub fn finish(&self) -> u64 {
+        self.0
+    }
+}
+
+impl Default for StableHasher {
+    fn default() -> Self {
+        Self::new()
+    }
+}
+
+/// Stores sorted load orders by the fingerprint of the inputs that produced
+/// them, optionally persisting them to a file.
+///
+/// New results are only written to the file when the cache is flushed.
+#[derive(Debug)]
+pub struct SortResultCache {
+    entries: Mutex<Entries>,
+    path: Option<PathBuf>,
+}
+
+#[derive(Debug, Default)]
+struct Entries {
+    load_orders: HashMap<u64, Box<[String]>>,
+    insertion_order: VecDeque<u64>,
+    // True if there are entries that haven't been written to the cache file.
+    has_unsaved_changes: bool,
+}
+
+impl Entries {
+    fn insert(&mut self, fingerprint: u64, load_order: Box<[String]>) {
+        if self.load_orders.insert(fingerprint, load_order).is_none() {
+            self.insertion_order.push_back(fingerprint);
+        }
+
+        while self.insertion_order.len() > MAX_ENTRIES {
+            if let Some(oldest) = self.insertion_order.pop_front() {
+                self.load_orders.remove(&oldest);
+            }
+        }
+    }
+}
+
+impl SortResultCache {
+    /// Create a new cache. If a path is given, any results stored in that file
+    /// are loaded, and new results are written to it. The cache is an
+    /// optimisation, so a file that can't be read is logged and ignored.
+    pub fn new(path: Option<PathBuf>) -> Self {
+        let mut entries = Entries::default();
+
+        let read_result = path
+            .as_ref()
+            .filter(|p| p.exists())
+            .map(|p| (p, read_entries(p, &mut entries)));
+
+        if let Some((path, Err(e))) = read_result {
+            logging::warn!(
+                "Failed to read the sort result cache at \"{}\": {}",
+                path.display(),
+                e
+            );
+        }
+
+        Self {
+            entries: Mutex::new(entries),
+            path,
+        }
+    }
+
+    /// Get the cached load order for the given fingerprint, if there is one
+    /// and it contains exactly the given plugins. A load order that contains
+    /// different plugins can only have been stored for different inputs that
+    /// have the same fingerprint, so is ignored.
+    pub fn get(&self, fingerprint: u64, plugin_names: &[&str]) -> Option<Vec<String>> {
+        let Ok(entries) = self.entries.lock() else {
+            logging::error!("The sort result cache's lock is poisoned");
+            return None;
+        };
+
+        let load_order = entries.load_orders.get(&fingerprint)?;
+
+        if !is_permutation(load_order, plugin_names) {
+            logging::warn!(
+                "Ignoring the cached sort result for fingerprint {fingerprint:016x} as it does not contain the plugins being sorted"
+            );
+            return None;
+        }
+
+        Some(load_order.to_vec())
+    }
+
+    pub fn insert(&self, fingerprint: u64, load_order: &[String]) {
+        let Ok(mut entries) = self.entries.lock() else {
+            logging::error!("The sort result cache's lock is poisoned");
+            return;
+        };
+
+        entries.insert(fingerprint, load_order.into());
+        entries.has_unsaved_changes = self.path.is_some();
+    }
+
+    /// Write the cached results to the cache's file, if it has one and there
+    /// are results that haven't already been written.
+    pub fn flush(&self) -> std::io::Result<()> {
+        let Some(path) = &self.path else {
+            return Ok(());
+        };
+
+        let mut entries = self
+            .entries
+            .lock()
+            .map_err(|_e| std::io::Error::other("the sort result cache's lock is poisoned"))?;
+
+        if entries.has_unsaved_changes {
+            write_entries(path, &entries)?;
+            entries.has_unsaved_changes = false;
+        }
+
+        Ok(())
+    }
+}
+
+fn is_permutation(load_order: &[String], plugin_names: &[&str]) -> bool {
+    if load_order.len() != plugin_names.len() {
+        return false;
+    }
+
+    let mut load_order: Vec<_> = load_order.iter().map(String::as_str).collect();
+    let mut plugin_names = plugin_names.to_vec();
+    load_order.sort_unstable();
+    plugin_names.sort_unstable();
+
+    load_order == plugin_names
+}
+
+fn read_entries(path: &Path, entries: &mut Entries) -> std::io::Result<()> {
+    let mut lines = BufReader::new(File::open(path)?).lines();
+
+    if lines.next().transpose()?.as_deref() != Some(FILE_HEADER) {
+        logging::info!(
+            "Ignoring the sort result cache at \"{}\" as it was written by a different version of libloot",
+            path.display()
+        );
+        return Ok(());
+    }
+
+    for line in lines {
+        let line = line?;
+
+        let parsed = line.split_once(':').and_then(|(fingerprint, names)| {
+            let fingerprint = u64::from_str_radix(fingerprint, 16).ok()?;
+            let load_order = if names.is_empty() {
+                Box::default()
+            } else {
+                names.split(NAME_SEPARATOR).map(str::to_owned).collect()
+            };
+            Some((fingerprint, load_order))
+        });
+
+        if let Some((fingerprint, load_order)) = parsed {
+            entries.insert(fingerprint, load_order);
+        } else {
+            logging::warn!("Skipping invalid sort result cache entry: {line}");
+        }
+    }
+
+    Ok(())
+}
+
+fn write_entries(path: &Path, entries: &Entries) -> std::io::Result<()> {
+    // Write to a temporary file and then rename it so that the cache file is
+    // never left partially written.
+    let mut temp_path = path.as_os_str().to_owned();
+    temp_path.push(".tmp");
+    let temp_path = PathBuf::from(temp_path);
+
+    let mut writer = BufWriter::new(File::create(&temp_path)?);
+    writeln!(writer, "{FILE_HEADER}")?;
+
+    for fingerprint in &entries.insertion_order {
+        let Some(load_order) = entries.load_orders.get(fingerprint) else {
+            continue;
+        };
+
+        // Entries are line-based, so skip any that can't be written unambiguously.
+        if load_order
+            .iter()
+            .any(|n| n.contains(['\n', '\r']) || n.contains(NAME_SEPARATOR))
+        {
+            continue;
+        }
+
+        writeln!(
+            writer,
+            "{fingerprint:016x}:{}",
+            load_order.join(NAME_SEPARATOR)
+        )?;
+    }
+
+    writer.into_inner()?.sync_all()?;
+
+    std::fs::rename(temp_path, path)
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn load_order(names: &[&str]) -> Vec<String> {
+        names.iter().map(|n| (*n).to_owned()).collect()
+    }
+
+    mod stable_hasher {
+        use super::*;
+
+        #[test]
+        fn finish_should_give_the_fnv_1a_hash_of_the_written_bytes() {
+            let mut hasher = StableHasher::new();
+            hasher.write_bytes(b"a");
+
+            assert_eq!(0xAF63_DC4C_8601_EC8C, hasher.finish());
+        }
+
+        #[test]
+        fn write_str_should_not_let_adjacent_strings_run_together() {
+            let mut first = StableHasher::new();
+            first.write_str("ab");
+            first.write_str("c");
+
+            let mut second = StableHasher::new();
+            second.write_str("a");
+            second.write_str("bc");
+
+            assert_ne!(first.finish(), second.finish());
+        }
+    }
+
+    mod sort_result_cache {
+        use super::*;
+
+        const A_B: &[&str] = &["A.esp", "B.esp"];
+
+        #[test]
+        fn get_should_return_none_if_the_fingerprint_is_not_cached() {
+            let cache = SortResultCache::new(None);
+
+            assert!(cache.get(1, A_B).is_none());
+        }
+
+        #[test]
+        fn get_should_return_the_load_order_inserted_with_the_same_fingerprint() {
+            let cache = SortResultCache::new(None);
+
+            cache.insert(1, &load_order(&["A.esp", "B.esp"]));
+            cache.insert(2, &load_order(&["B.esp", "A.esp"]));
+
+            assert_eq!(load_order(&["A.esp", "B.esp"]), cache.get(1, A_B).unwrap());
+            assert_eq!(load_order(&["B.esp", "A.esp"]), cache.get(2, A_B).unwrap());
+        }
+
+        #[test]
+        fn get_should_return_none_if_the_cached_load_order_has_different_plugins() {
+            let cache = SortResultCache::new(None);
+
+            cache.insert(1, &load_order(&["A.esp", "B.esp"]));
+
+            assert!(cache.get(1, &["A.esp"]).is_none());
+            assert!(cache.get(1, &["A.esp", "C.esp"]).is_none());
+            assert!(cache.get(1, &["A.esp", "B.esp", "C.esp"]).is_none());
+        }
+
+        #[test]
+        fn insert_should_evict_the_oldest_entry_when_the_cache_is_full() {
+            let cache = SortResultCache::new(None);
+
+            for i in 0..=u64::try_from(MAX_ENTRIES).unwrap() {
+                cache.insert(i, &load_order(&["A.esp"]));
+            }
+
+            assert!(cache.get(0, &["A.esp"]).is_none());
+            assert!(cache.get(1, &["A.esp"]).is_some());
+        }
+
+        #[test]
+        fn insert_should_not_write_to_the_cache_file() {
+            let tmp_dir = tempfile::tempdir().unwrap();
+            let path = tmp_dir.path().join("sort-cache.txt");
+
+            let cache = SortResultCache::new(Some(path.clone()));
+            cache.insert(0xABCD, &load_order(&["A.esp", "B.esp"]));
+
+            assert!(!path.exists());
+        }
+
+        #[test]
+        fn new_should_load_entries_written_by_a_previous_cache() {
+            let tmp_dir = tempfile::tempdir().unwrap();
+            let path = tmp_dir.path().join("sort-cache.txt");
+
+            let cache = SortResultCache::new(Some(path.clone()));
+            cache.insert(0xABCD, &load_order(&["A.esp", "B.esp"]));
+            cache.insert(0xEF01, &[]);
+            cache.flush().unwrap();
+            drop(cache);
+
+            let cache = SortResultCache::new(Some(path));
+
+            assert_eq!(
+                load_order(&["A.esp", "B.esp"]),
+                cache.get(0xABCD, A_B).unwrap()
+            );
+            assert!(cache.get(0xEF01, &[]).unwrap().is_empty());
+        }
+
+        #[test]
+        fn new_should_ignore_a_file_written_by_a_different_version() {
+            let tmp_dir = tempfile::tempdir().unwrap();
+            let path = tmp_dir.path().join("sort-cache.txt");
+
+            std::fs::write(
+                &path,
+                "libloot sort result cache v0 0.0.0\n000000000000abcd:A.esp\n",
+            )
+            .unwrap();
+
+            let cache = SortResultCache::new(Some(path));
+
+            assert!(cache.get(0xABCD, &["A.esp"]).is_none());
+        }
+    }
+}